@@ -0,0 +1,379 @@
+// Game micro-benchmarks behind `make bench`.
+//
+// Every case runs with fixed seeds and reports ns/op and heap
+// allocations/op. Results are written as JSON and compared against a
+// stored baseline; a case that got slower or allocates more than the
+// baseline by more than the threshold is flagged and the exit code is 2.
+//
+// Usage: bench [--json out.json] [--baseline file] [--write-baseline file]
+//              [--threshold 0.15] [--min-ms 300] [--filter substring]
+//        bench --compare label=results.json [--compare label=results.json ...]
+//              (table of earlier runs side by side, e.g. one per build variant)
+
+#include "Duck.h"
+#include "DuckPhysics.h"
+#include "ParticleSystem.h"
+#include "Random.h"
+#include "TronBot.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+
+// ---- allocation counting ----
+
+static std::atomic<unsigned long long> g_allocs(0);
+
+void* operator new(std::size_t size) {
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+struct Result {
+    std::string name;
+    unsigned long long ops = 0;
+    double nsPerOp = 0.0;
+    double allocsPerOp = 0.0;
+};
+
+struct Options {
+    std::string jsonPath = "bin/bench.json";
+    std::string baselinePath;
+    std::string writeBaselinePath;
+    double threshold = 0.15;
+    double minMs = 300.0;
+    std::string filter;
+    std::vector<std::pair<std::string, std::string>> compare; // label, json path
+};
+
+// Calls fn (which performs opsPerCall operations) until minMs has passed
+template <class Fn>
+Result measure(const Options& opt, const char* name, unsigned opsPerCall, Fn fn) {
+    fn(); // warm-up: first-touch allocations and caches do not count
+    Result r;
+    r.name = name;
+    unsigned long long calls = 0;
+    unsigned long long allocs0 = g_allocs.load();
+    auto t0 = Clock::now();
+    double elapsedMs = 0.0;
+    do {
+        fn();
+        ++calls;
+        elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    } while (elapsedMs < opt.minMs);
+    unsigned long long allocs = g_allocs.load() - allocs0;
+    r.ops = calls * opsPerCall;
+    r.nsPerOp = elapsedMs * 1e6 / static_cast<double>(r.ops);
+    r.allocsPerOp = static_cast<double>(allocs) / static_cast<double>(r.ops);
+    return r;
+}
+
+// Keeps the optimiser from discarding benchmark results
+volatile std::size_t g_sink = 0;
+
+const sf::Vector2u FIELD(800, 600);
+const int DUCKS = 64;
+
+std::vector<std::unique_ptr<Duck>> makeDucks() {
+    seedRandom(42);
+    std::vector<std::unique_ptr<Duck>> ducks;
+    for (int i = 0; i < DUCKS; ++i) {
+        sf::Vector2f pos(static_cast<float>(i * 12 % FIELD.x), 80.f + static_cast<float>(i * 7 % 300));
+        ducks.push_back(std::unique_ptr<Duck>(new Duck(pos, FIELD, "assets/images/duck.png")));
+    }
+    return ducks;
+}
+
+Result benchDuckUpdate(const Options& opt) {
+    auto ducks = makeDucks();
+    return measure(opt, "duck_update", DUCKS, [&]() {
+        for (auto& d : ducks) d->update(1.f / 60.f);
+    });
+}
+
+// A field four windows wide seen through one window-sized view, so most
+// ducks are far off screen and run the coarse path, as in Game::update
+Result benchDuckUpdateCulled(const Options& opt) {
+    const sf::Vector2u wide(FIELD.x * 4, FIELD.y);
+    const sf::FloatRect view(0.f, 0.f, static_cast<float>(FIELD.x), static_cast<float>(FIELD.y));
+    seedRandom(42);
+    std::vector<std::unique_ptr<Duck>> ducks;
+    for (int i = 0; i < DUCKS; ++i) {
+        sf::Vector2f pos(static_cast<float>(i * 48 % wide.x), 80.f + static_cast<float>(i * 7 % 300));
+        ducks.push_back(std::unique_ptr<Duck>(new Duck(pos, wide, "assets/images/duck.png")));
+    }
+    return measure(opt, "duck_update_culled", DUCKS, [&]() {
+        for (auto& d : ducks) {
+            d->updateLod(view);
+            d->update(1.f / 60.f);
+        }
+    });
+}
+
+Result benchHitTest(const Options& opt) {
+    auto ducks = makeDucks();
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> x(0.f, static_cast<float>(FIELD.x));
+    std::uniform_real_distribution<float> y(0.f, static_cast<float>(FIELD.y));
+    std::vector<sf::Vector2f> clicks(256);
+    for (auto& c : clicks) c = sf::Vector2f(x(rng), y(rng));
+    std::size_t next = 0;
+    // one op = one click tested against every duck, as in Game::handleInput
+    return measure(opt, "hit_test", 1, [&]() {
+        const sf::Vector2f& p = clicks[next++ & 255];
+        for (auto& d : ducks) {
+            if (d->isAlive() && !d->isFalling() && d->hitTest(p)) {
+                g_sink = g_sink + 1;
+                break;
+            }
+        }
+    });
+}
+
+Result benchTextureKeyFlip(const Options& opt) {
+    sf::Image image;
+    if (!image.loadFromFile("assets/images/duck.png")) {
+        // deterministic stand-in with the same mix of keyed and opaque pixels
+        image.create(256, 192, sf::Color::White);
+        for (unsigned y = 40; y < 150; ++y)
+            for (unsigned x = 50; x < 210; ++x) image.setPixel(x, y, sf::Color(80, 160, 40));
+    }
+    return measure(opt, "texture_key_flip", 1, [&]() {
+        sf::Image out = Duck::keyAndFlip(image);
+        g_sink = g_sink + out.getSize().x;
+    });
+}
+
+Result benchHudFormat(const Options& opt) {
+    int score = 0, lives = 3;
+    // same strings Game::update builds every frame
+    return measure(opt, "hud_format", 1, [&]() {
+        std::string s = std::string("Score: ") + std::to_string(score);
+        std::string l = std::string("Lives: ") + std::to_string(lives);
+        score += 100;
+        g_sink = g_sink + s.size() + l.size();
+    });
+}
+
+Result benchTronDecide(const Options& opt) {
+    // fixed depth and a budget it never reaches, so the work is identical every run
+    TronBot bot(std::chrono::microseconds(10000000), 3);
+    TronGrid& grid = bot.Grid();
+    grid.Resize(24, 24);
+    std::mt19937 rng(3);
+    for (int i = 0; i < 80; ++i) grid.Set(static_cast<int>(rng() % grid.Size()), true);
+    int me = grid.Index(4, 12), enemy = grid.Index(19, 12);
+    grid.Set(me, false);
+    grid.Set(enemy, false);
+    return measure(opt, "tron_decide", 1, [&]() {
+        g_sink = g_sink + static_cast<std::size_t>(bot.Decide(me, 3, enemy));
+    });
+}
+
+Result benchPhysicsStep(const Options& opt) {
+    const sf::Vector2f field(800.f, 600.f);
+    DuckPhysics physics(field, field.y - 120.f);
+    physics.setCorpseLifetime(-1.f);
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> jitter(-4.f, 4.f);
+    for (int i = 0; i < 200; ++i) {
+        float x = 20.f + 38.f * (i % 20) + jitter(rng);
+        float y = field.y - 160.f - 36.f * (i / 20);
+        physics.createDuckBody({x, y}, {16.f, 16.f}, 0.f, {0.f, -100.f}, jitter(rng) * 50.f);
+    }
+    // steady state of a long round: a settled pile of 200 corpses
+    for (int s = 0; s < 600; ++s) physics.step(DuckPhysics::TIME_STEP);
+    return measure(opt, "physics_step_200", 1, [&]() { physics.step(DuckPhysics::TIME_STEP); });
+}
+
+Result benchParticles(const Options& opt) {
+    // 100k live particles; each op is one frame's update with the pool kept full
+    const std::size_t live = 100000;
+    ParticleSystem particles(live);
+    ParticleSystem::Burst burst;
+    burst.count = 100;
+    burst.lifeMin = 1.f;
+    burst.lifeMax = 3.f;
+    burst.gravity = 120.f;
+    int spot = 0;
+    return measure(opt, "particles_100k", 1, [&]() {
+        for (; particles.size() + burst.count <= live; ++spot)
+            particles.emit(sf::Vector2f(static_cast<float>(spot * 37 % 800), static_cast<float>(spot * 53 % 600)), burst);
+        particles.update(1.f / 60.f);
+    });
+}
+
+// ---- JSON ----
+
+void writeJson(const std::string& path, const std::vector<Result>& results) {
+    std::ofstream out(path);
+    if (!out) {
+        std::fprintf(stderr, "could not write '%s'\n", path.c_str());
+        return;
+    }
+    out << "{\n  \"benchmarks\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        char line[256];
+        std::snprintf(line, sizeof(line),
+                      "    {\"name\": \"%s\", \"ns_per_op\": %.3f, \"allocs_per_op\": %.4f, \"ops\": %llu}%s\n",
+                      r.name.c_str(), r.nsPerOp, r.allocsPerOp, r.ops, i + 1 < results.size() ? "," : "");
+        out << line;
+    }
+    out << "  ]\n}\n";
+}
+
+// Reads the files writeJson produces (one benchmark object per line)
+std::map<std::string, Result> readJson(const std::string& path) {
+    std::map<std::string, Result> out;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        std::size_t n = line.find("\"name\": \"");
+        if (n == std::string::npos) continue;
+        Result r;
+        n += 9;
+        r.name = line.substr(n, line.find('"', n) - n);
+        std::size_t ns = line.find("\"ns_per_op\": ");
+        std::size_t al = line.find("\"allocs_per_op\": ");
+        if (ns == std::string::npos || al == std::string::npos) continue;
+        r.nsPerOp = std::atof(line.c_str() + ns + 13);
+        r.allocsPerOp = std::atof(line.c_str() + al + 17);
+        out[r.name] = r;
+    }
+    return out;
+}
+
+bool parseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (i + 1 >= argc) return false;
+        if (a == "--json") opt.jsonPath = argv[++i];
+        else if (a == "--baseline") opt.baselinePath = argv[++i];
+        else if (a == "--write-baseline") opt.writeBaselinePath = argv[++i];
+        else if (a == "--threshold") opt.threshold = std::atof(argv[++i]);
+        else if (a == "--min-ms") opt.minMs = std::atof(argv[++i]);
+        else if (a == "--filter") opt.filter = argv[++i];
+        else if (a == "--compare") {
+            std::string spec = argv[++i];
+            std::size_t eq = spec.find('=');
+            if (eq == std::string::npos) return false;
+            opt.compare.push_back(std::make_pair(spec.substr(0, eq), spec.substr(eq + 1)));
+        }
+        else return false;
+    }
+    return true;
+}
+
+// ns/op of each run side by side, with the speedup over the first run
+int compareRuns(const Options& opt) {
+    std::vector<std::map<std::string, Result>> runs;
+    std::vector<std::string> names;
+    for (const auto& c : opt.compare) {
+        runs.push_back(readJson(c.second));
+        if (runs.back().empty()) std::printf("warning: no results in '%s'\n", c.second.c_str());
+        for (const auto& r : runs.back())
+            if (std::find(names.begin(), names.end(), r.first) == names.end()) names.push_back(r.first);
+    }
+
+    std::printf("%-18s", "ns/op");
+    for (const auto& c : opt.compare) std::printf(" %18s", c.first.c_str());
+    std::printf("\n");
+    for (const std::string& name : names) {
+        std::printf("%-18s", name.c_str());
+        auto first = runs[0].find(name);
+        for (std::size_t i = 0; i < runs.size(); ++i) {
+            auto r = runs[i].find(name);
+            if (r == runs[i].end()) {
+                std::printf(" %18s", "-");
+            } else if (i == 0 || first == runs[0].end() || r->second.nsPerOp <= 0.0) {
+                std::printf(" %18.1f", r->second.nsPerOp);
+            } else {
+                std::printf(" %10.1f (x%4.2f)", r->second.nsPerOp, first->second.nsPerOp / r->second.nsPerOp);
+            }
+        }
+        std::printf("\n");
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        std::fprintf(stderr, "usage: %s [--json file] [--baseline file] [--write-baseline file] "
+                             "[--threshold frac] [--min-ms ms] [--filter text] | --compare label=file...\n", argv[0]);
+        return 1;
+    }
+    if (!opt.compare.empty()) return compareRuns(opt);
+
+    typedef Result (*Case)(const Options&);
+    const std::pair<const char*, Case> cases[] = {
+        {"duck_update", benchDuckUpdate},
+        {"duck_update_culled", benchDuckUpdateCulled},
+        {"hit_test", benchHitTest},
+        {"texture_key_flip", benchTextureKeyFlip},
+        {"hud_format", benchHudFormat},
+        {"tron_decide", benchTronDecide},
+        {"physics_step_200", benchPhysicsStep},
+        {"particles_100k", benchParticles},
+    };
+
+    std::vector<Result> results;
+    for (const auto& c : cases) {
+        if (!opt.filter.empty() && std::string(c.first).find(opt.filter) == std::string::npos) continue;
+        results.push_back(c.second(opt));
+    }
+
+    std::map<std::string, Result> baseline;
+    if (!opt.baselinePath.empty()) {
+        baseline = readJson(opt.baselinePath);
+        if (baseline.empty())
+            std::printf("no baseline in '%s' (create one with make bench-baseline)\n", opt.baselinePath.c_str());
+    }
+
+    int regressions = 0;
+    std::printf("%-18s %14s %14s %12s\n", "benchmark", "ns/op", "allocs/op", "vs baseline");
+    for (const Result& r : results) {
+        std::printf("%-18s %14.1f %14.3f", r.name.c_str(), r.nsPerOp, r.allocsPerOp);
+        auto b = baseline.find(r.name);
+        if (b == baseline.end()) {
+            std::printf("\n");
+            continue;
+        }
+        double change = b->second.nsPerOp > 0.0 ? r.nsPerOp / b->second.nsPerOp - 1.0 : 0.0;
+        bool slower = change > opt.threshold;
+        bool moreAllocs = r.allocsPerOp > b->second.allocsPerOp * (1.0 + opt.threshold) + 0.01;
+        std::printf(" %+11.1f%%%s%s\n", change * 100.0, slower ? "  SLOWER" : "", moreAllocs ? "  MORE ALLOCS" : "");
+        if (slower || moreAllocs) ++regressions;
+    }
+
+    if (!opt.jsonPath.empty()) writeJson(opt.jsonPath, results);
+    if (!opt.writeBaselinePath.empty()) {
+        writeJson(opt.writeBaselinePath, results);
+        std::printf("baseline written to '%s'\n", opt.writeBaselinePath.c_str());
+    }
+    if (regressions) {
+        std::printf("%d regression(s) beyond %.0f%%\n", regressions, opt.threshold * 100.0);
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,110 @@
+// Spawns thousands of Chipmunk balls with one Ball object each and with
+// BallPool, and compares spawn, step, position read-back and removal time.
+//
+// Usage: chipmunk_bench [balls] [steps]
+
+#include "Ball.hpp"
+#include "BallPool.hpp"
+#include "Ground.hpp"
+#include "PhysicsSpace.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+volatile float sink; // keeps the read-back loops from being optimised away
+
+double msSince(Clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+struct Result {
+    double spawnMs, stepMs, readMs, removeMs;
+};
+
+std::vector<cpVect> spawnPoints(int count) {
+    std::vector<cpVect> pts;
+    pts.reserve(count);
+    const int columns = 79; // odd rows sit 5 px right: x stays within 10..795, on the 0..800 ground
+    for (int i = 0; i < count; ++i)
+        pts.push_back(cpv(10.0 + (i % columns) * 10.0 + (i / columns % 2) * 5.0, 480.0 - (i / columns) * 10.0));
+    return pts;
+}
+
+Result runObjects(const std::vector<cpVect>& pts, int steps) {
+    PhysicsSpace physics;
+    Suelo suelo(physics.getSpace());
+    Result r;
+
+    auto t0 = Clock::now();
+    std::vector<std::unique_ptr<Ball>> balls;
+    for (const cpVect& p : pts) balls.emplace_back(new Ball(physics.getSpace(), 4.f, 1.f, p));
+    r.spawnMs = msSince(t0);
+
+    t0 = Clock::now();
+    for (int s = 0; s < steps; ++s) cpSpaceStep(physics.getSpace(), 1.0 / 60.0);
+    r.stepMs = msSince(t0) / steps;
+
+    t0 = Clock::now();
+    float sum = 0.f;
+    for (auto& b : balls) sum += b->GetShape().getPosition().y;
+    r.readMs = msSince(t0);
+    sink = sum;
+
+    t0 = Clock::now();
+    balls.clear();
+    r.removeMs = msSince(t0);
+    return r;
+}
+
+Result runPool(const std::vector<cpVect>& pts, int steps) {
+    PhysicsSpace physics;
+    Suelo suelo(physics.getSpace());
+    Result r;
+
+    auto t0 = Clock::now();
+    BallPool pool(physics.getSpace(), pts.size(), 4.f, 1.f);
+    pool.addBatch(pts.data(), pts.size());
+    r.spawnMs = msSince(t0);
+
+    t0 = Clock::now();
+    for (int s = 0; s < steps; ++s) cpSpaceStep(physics.getSpace(), 1.0 / 60.0);
+    r.stepMs = msSince(t0) / steps;
+
+    t0 = Clock::now();
+    pool.syncPositions();
+    float sum = 0.f;
+    for (const sf::Vector2f& p : pool.positions()) sum += p.y;
+    r.readMs = msSince(t0);
+    sink = sum;
+
+    t0 = Clock::now();
+    std::vector<BallPool::Handle> all = pool.handles();
+    pool.removeBatch(all.data(), all.size());
+    r.removeMs = msSince(t0);
+    return r;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int count = argc > 1 ? std::atoi(argv[1]) : 5000;
+    int steps = argc > 2 ? std::atoi(argv[2]) : 120;
+    if (steps < 1) steps = 1;
+
+    std::vector<cpVect> pts = spawnPoints(count);
+    Result objects = runObjects(pts, steps);
+    Result pooled = runPool(pts, steps);
+
+    std::printf("%d balls, %d steps\n", count, steps);
+    std::printf("%-10s %10s %10s %10s %10s\n", "", "spawn ms", "step ms", "read ms", "remove ms");
+    std::printf("%-10s %10.3f %10.3f %10.3f %10.3f\n", "Ball", objects.spawnMs, objects.stepMs, objects.readMs, objects.removeMs);
+    std::printf("%-10s %10.3f %10.3f %10.3f %10.3f\n", "BallPool", pooled.spawnMs, pooled.stepMs, pooled.readMs, pooled.removeMs);
+    return 0;
+}
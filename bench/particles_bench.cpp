@@ -0,0 +1,104 @@
+// Keeps N particles alive (default 100k) and reports the per-frame cost of
+// ParticleSystem::update (integration + vertex rebuild) against the 60 FPS
+// frame budget, plus the heap allocations made during the timed frames,
+// which must be zero. With --draw the particles are also drawn into an
+// offscreen render texture (needs a GL context).
+//
+// Usage: particles_bench [particles] [frames] [--draw]
+
+#include "ParticleSystem.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+static std::atomic<unsigned long long> g_allocs(0);
+
+void* operator new(std::size_t size) {
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+int main(int argc, char** argv) {
+    std::size_t target = 100000;
+    int frames = 600;
+    bool draw = false;
+    int positional = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--draw")) draw = true;
+        else if (positional++ == 0) target = static_cast<std::size_t>(std::atol(argv[i]));
+        else frames = std::atoi(argv[i]);
+    }
+    if (frames < 1) frames = 1;
+
+    typedef std::chrono::steady_clock Clock;
+    const float dt = 1.f / 60.f;
+    const double budgetMs = 1000.0 / 60.0;
+
+    ParticleSystem particles(target);
+    sf::RenderTexture rt;
+    if (draw && !rt.create(800, 600)) {
+        std::fprintf(stderr, "could not create an offscreen render texture, drawing disabled\n");
+        draw = false;
+    }
+
+    // Bursts spread over the field; long lives so the pool stays full
+    ParticleSystem::Burst burst;
+    burst.count = 100;
+    burst.lifeMin = 1.f;
+    burst.lifeMax = 3.f;
+    burst.gravity = 120.f;
+    burst.drag = 1.f;
+    int spot = 0;
+    auto refill = [&]() {
+        while (particles.size() + burst.count <= target) {
+            particles.emit(sf::Vector2f(static_cast<float>(spot * 37 % 800), static_cast<float>(spot * 53 % 600)), burst);
+            ++spot;
+        }
+    };
+
+    refill();
+    particles.update(dt); // warm-up
+
+    double totalMs = 0.0, worstMs = 0.0, drawMs = 0.0;
+    unsigned long long allocs0 = g_allocs.load();
+    for (int f = 0; f < frames; ++f) {
+        refill();
+        auto t0 = Clock::now();
+        particles.update(dt);
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        totalMs += ms;
+        worstMs = std::max(worstMs, ms);
+        if (draw) {
+            auto d0 = Clock::now();
+            rt.clear();
+            rt.draw(particles);
+            rt.display();
+            drawMs += std::chrono::duration<double, std::milli>(Clock::now() - d0).count();
+        }
+    }
+    if (draw) {
+        auto d0 = Clock::now();
+        sf::Image sync = rt.getTexture().copyToImage(); // wait for the GPU
+        (void)sync;
+        drawMs += std::chrono::duration<double, std::milli>(Clock::now() - d0).count();
+    }
+    unsigned long long allocs = g_allocs.load() - allocs0;
+
+    std::printf("%zu live particles, %d frames\n", particles.size(), frames);
+    std::printf("update : %8.3f ms/frame mean, %8.3f ms worst (%.0f%% of the %.2f ms budget)\n", totalMs / frames, worstMs,
+                100.0 * (totalMs / frames) / budgetMs, budgetMs);
+    if (draw) std::printf("draw   : %8.3f ms/frame mean\n", drawMs / frames);
+    std::printf("allocations during timed frames: %llu%s\n", allocs, allocs && !draw ? "  FAIL" : "");
+    return allocs && !draw ? 1 : 0;
+}
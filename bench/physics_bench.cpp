@@ -0,0 +1,70 @@
+// Step-time benchmark for the duck physics world (include/DuckPhysics.h).
+// Drops N duck bodies onto the grass and reports the mean step time while
+// the pile is settling and once it has gone to sleep.
+//
+// Usage: physics_bench [max_bodies]
+
+#include "DuckPhysics.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Sample {
+    int bodies;
+    double settlingUs;
+    double restingUs;
+    int awake;
+};
+
+Sample run(int count) {
+    const sf::Vector2f field(1600.f, 900.f);
+    const float groundY = field.y - 120.f;
+    DuckPhysics physics(field, groundY);
+    physics.setCorpseLifetime(-1.f);
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> jitter(-4.f, 4.f);
+    std::uniform_real_distribution<float> spin(-300.f, 300.f);
+
+    // drop them in columns so they land on each other
+    const int columns = 40;
+    const float spacing = field.x / columns;
+    for (int i = 0; i < count; ++i) {
+        float x = spacing * (i % columns) + spacing / 2.f + jitter(rng);
+        float y = groundY - 40.f - 36.f * (i / columns);
+        physics.createDuckBody({x, y}, {16.f, 16.f}, 0.f, {jitter(rng) * 10.f, -200.f}, spin(rng));
+    }
+
+    typedef std::chrono::steady_clock Clock;
+    auto measure = [&](int steps) {
+        auto t0 = Clock::now();
+        for (int s = 0; s < steps; ++s) physics.step(DuckPhysics::TIME_STEP);
+        return std::chrono::duration<double, std::micro>(Clock::now() - t0).count() / steps;
+    };
+
+    Sample out;
+    out.bodies = count;
+    out.settlingUs = measure(120);  // first two seconds: falling and stacking
+    measure(600);                   // let the pile come to rest
+    out.restingUs = measure(120);
+    out.awake = physics.awakeBodyCount();
+    return out;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int maxBodies = argc > 1 ? std::atoi(argv[1]) : 3200;
+
+    std::printf("%8s %14s %14s %8s\n", "bodies", "settling us", "resting us", "awake");
+    for (int n = 50; n <= maxBodies; n *= 2) {
+        Sample s = run(n);
+        std::printf("%8d %14.1f %14.1f %8d\n", s.bodies, s.settlingUs, s.restingUs, s.awake);
+    }
+    return 0;
+}
@@ -0,0 +1,121 @@
+// Draws N static primitives into an offscreen render texture, the way
+// 06_Primitivas used to (shapes rebuilt and drawn one by one every frame)
+// and through ShapeCache (built once, one draw call), and reports the mean
+// frame time of each.
+//
+// Usage: primitives_bench [primitives] [frames]
+
+#include "ShapeCache.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+// Same three primitive kinds as 06_Primitivas, laid out on a grid
+sf::Vector2f cellPosition(int i) {
+    return sf::Vector2f(static_cast<float>((i * 7) % 800), static_cast<float>((i / 114 * 5) % 600));
+}
+
+void drawImmediate(sf::RenderTarget& target, int count) {
+    for (int i = 0; i < count; ++i) {
+        sf::Vector2f p = cellPosition(i);
+        switch (i % 3) {
+        case 0: {
+            sf::CircleShape circle(3);
+            circle.setFillColor(sf::Color::Red);
+            circle.setPosition(p);
+            target.draw(circle);
+            break;
+        }
+        case 1: {
+            sf::RectangleShape rectangle(sf::Vector2f(6, 4));
+            rectangle.setFillColor(sf::Color::Green);
+            rectangle.setPosition(p);
+            target.draw(rectangle);
+            break;
+        }
+        default: {
+            sf::ConvexShape triangle;
+            triangle.setPointCount(3);
+            triangle.setPoint(0, sf::Vector2f(0, 0));
+            triangle.setPoint(1, sf::Vector2f(6, 0));
+            triangle.setPoint(2, sf::Vector2f(3, 6));
+            triangle.setFillColor(sf::Color::Blue);
+            triangle.setPosition(p);
+            target.draw(triangle);
+            break;
+        }
+        }
+    }
+}
+
+void buildRetained(ShapeCache& cache, int count) {
+    sf::CircleShape circle(3);
+    circle.setFillColor(sf::Color::Red);
+    sf::RectangleShape rectangle(sf::Vector2f(6, 4));
+    rectangle.setFillColor(sf::Color::Green);
+    sf::ConvexShape triangle;
+    triangle.setPointCount(3);
+    triangle.setPoint(0, sf::Vector2f(0, 0));
+    triangle.setPoint(1, sf::Vector2f(6, 0));
+    triangle.setPoint(2, sf::Vector2f(3, 6));
+    triangle.setFillColor(sf::Color::Blue);
+
+    for (int i = 0; i < count; ++i) {
+        sf::Shape& shape = i % 3 == 0 ? static_cast<sf::Shape&>(circle)
+                         : i % 3 == 1 ? static_cast<sf::Shape&>(rectangle)
+                                      : static_cast<sf::Shape&>(triangle);
+        shape.setPosition(cellPosition(i));
+        cache.add(shape);
+    }
+    cache.update();
+}
+
+// Mean ms per frame; reading the texture back at the end waits for the GPU
+template <class DrawFn>
+double timeFrames(sf::RenderTexture& rt, int frames, DrawFn drawFrame) {
+    auto t0 = Clock::now();
+    for (int f = 0; f < frames; ++f) {
+        rt.clear();
+        drawFrame();
+        rt.display();
+    }
+    sf::Image sync = rt.getTexture().copyToImage();
+    (void)sync;
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count() / frames;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int count = argc > 1 ? std::atoi(argv[1]) : 100000;
+    int frames = argc > 2 ? std::atoi(argv[2]) : 30;
+    if (frames < 1) frames = 1;
+
+    sf::RenderTexture rt;
+    if (!rt.create(800, 600)) {
+        std::fprintf(stderr, "could not create an offscreen render texture\n");
+        return 1;
+    }
+
+    double immediate = timeFrames(rt, frames, [&]() { drawImmediate(rt, count); });
+
+    auto t0 = Clock::now();
+    ShapeCache cache;
+    buildRetained(cache, count);
+    double buildMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    double retained = timeFrames(rt, frames, [&]() {
+        cache.update();
+        rt.draw(cache);
+    });
+
+    std::printf("%d primitives, %d frames, vertex buffers %s\n", count, frames,
+                sf::VertexBuffer::isAvailable() ? "available" : "unavailable");
+    std::printf("immediate : %10.3f ms/frame\n", immediate);
+    std::printf("retained  : %10.3f ms/frame (one-off build %.3f ms, %zu vertices)\n", retained, buildMs, cache.vertexCount());
+    return 0;
+}
@@ -0,0 +1,87 @@
+// Drops N balls on the Suelo ground under several PhysicsSpace::Config
+// presets and reports the mean step time of each, so broad-phase and solver
+// settings can be chosen from measurements.
+//
+// Usage: space_config_bench [balls] [seconds]
+
+#include "BallPool.hpp"
+#include "Ground.hpp"
+#include "PhysicsSpace.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+const float RADIUS = 4.f;
+
+struct Preset {
+    const char* name;
+    PhysicsSpace::Config config;
+};
+
+std::vector<Preset> presets(int balls) {
+    std::vector<Preset> out;
+    PhysicsSpace::Config c;
+    out.push_back({"bbtree (default)", c});
+
+    c.useSpatialHash = true;
+    c.hashCellSize = RADIUS * 2.0;
+    c.hashCount = balls * 10;
+    out.push_back({"spatial hash", c});
+
+    c.iterations = 5;
+    out.push_back({"hash, 5 iterations", c});
+
+    c.sleepTimeThreshold = 0.5;
+    out.push_back({"hash, 5 it, sleep", c});
+
+    c.collisionSlop = 0.5;
+    out.push_back({"hash, 5 it, sleep, slop", c});
+
+    PhysicsSpace::Config tree;
+    tree.sleepTimeThreshold = 0.5;
+    out.push_back({"bbtree, sleep", tree});
+    return out;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int balls = argc > 1 ? std::atoi(argv[1]) : 3000;
+    float seconds = argc > 2 ? static_cast<float>(std::atof(argv[2])) : 4.f;
+    const int steps = static_cast<int>(seconds * 60.f) > 0 ? static_cast<int>(seconds * 60.f) : 1;
+
+    // columns over the 800 px wide ground, stacked upwards from just above it
+    std::vector<cpVect> pts;
+    const int columns = 78;
+    for (int i = 0; i < balls; ++i)
+        pts.push_back(cpv(15.0 + (i % columns) * 10.0 + (i / columns % 2) * 3.0, 490.0 - (i / columns) * 10.0));
+
+    std::printf("%d balls, %d steps\n", balls, steps);
+    std::printf("%-26s %12s %12s %12s\n", "config", "mean ms", "first s ms", "last s ms");
+    for (const Preset& p : presets(balls)) {
+        PhysicsSpace physics(p.config);
+        Suelo suelo(physics.getSpace());
+        BallPool pool(physics.getSpace(), pts.size(), RADIUS, 1.f);
+        pool.addBatch(pts.data(), pts.size());
+
+        std::vector<double> stepMs(steps);
+        for (int s = 0; s < steps; ++s) {
+            auto t0 = std::chrono::steady_clock::now();
+            cpSpaceStep(physics.getSpace(), 1.0 / 60.0);
+            stepMs[s] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        }
+
+        auto mean = [&](int from, int to) {
+            double sum = 0.0;
+            for (int i = from; i < to; ++i) sum += stepMs[i];
+            return to > from ? sum / (to - from) : 0.0;
+        };
+        int window = steps < 60 ? steps : 60;
+        std::printf("%-26s %12.3f %12.3f %12.3f\n", p.name, mean(0, steps), mean(0, window), mean(steps - window, steps));
+    }
+    return 0;
+}
@@ -0,0 +1,150 @@
+// Headless bot-vs-bot harness for the Tron bot (include/TronBot.hpp).
+// Plays many rounds in parallel across all cores and reports rounds per
+// second and per-decision latency percentiles.
+//
+// Usage: tron_bench [--rounds N] [--threads N] [--size N] [--budget-us N] [--depth N] [--seed N]
+
+#include "TronBot.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+struct Options {
+    int rounds = 1000;
+    int threads = 0; // 0 = one per core
+    int size = 24;
+    int budgetUs = 500;
+    int depth = 3;
+    unsigned seed = 1234;
+};
+
+struct WorkerResult {
+    std::vector<long long> latenciesNs;
+    long long ticks = 0;
+    int wins[2] = {0, 0};
+    int draws = 0;
+};
+
+// Plays one round. Rules match 08_Tron.cpp: both heads move every tick,
+// running into any trail loses, meeting head-on is a draw.
+static void PlayRound(const Options& opt, unsigned seed, TronBot bots[2], WorkerResult& out)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> jitter(-opt.size / 8, opt.size / 8);
+    std::uniform_int_distribution<int> dirDist(0, 3);
+
+    TronGrid& g0 = bots[0].Grid();
+    TronGrid& g1 = bots[1].Grid();
+    if (g0.Width() != opt.size) { g0.Resize(opt.size, opt.size); g1.Resize(opt.size, opt.size); }
+    else { g0.Clear(); g1.Clear(); }
+
+    int head[2] = {
+        g0.Index(opt.size / 4 + jitter(rng), opt.size / 2 + jitter(rng)),
+        g0.Index(opt.size - opt.size / 4 + jitter(rng), opt.size / 2 + jitter(rng)),
+    };
+    if (head[0] == head[1]) head[1] = g0.Step(head[1], 3);
+    int dir[2] = {dirDist(rng), dirDist(rng)};
+    for (int p = 0; p < 2; ++p) { g0.Set(head[p], true); g1.Set(head[p], true); }
+
+    const int maxTicks = opt.size * opt.size;
+    for (int tick = 0; tick < maxTicks; ++tick) {
+        for (int p = 0; p < 2; ++p) {
+            auto t0 = std::chrono::steady_clock::now();
+            dir[p] = bots[p].Decide(head[p], dir[p], head[1 - p]);
+            auto t1 = std::chrono::steady_clock::now();
+            out.latenciesNs.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+        }
+        ++out.ticks;
+
+        int next[2] = {g0.Step(head[0], dir[0]), g0.Step(head[1], dir[1])};
+        bool crash[2] = {g0.Occupied(next[0]), g0.Occupied(next[1])};
+        if (next[0] == next[1] || (crash[0] && crash[1])) { ++out.draws; return; }
+        if (crash[0]) { ++out.wins[1]; return; }
+        if (crash[1]) { ++out.wins[0]; return; }
+
+        for (int p = 0; p < 2; ++p) {
+            head[p] = next[p];
+            g0.Set(head[p], true);
+            g1.Set(head[p], true);
+        }
+    }
+    ++out.draws;
+}
+
+static bool ParseInt(int argc, char** argv, int& i, const char* name, int& value)
+{
+    if (std::strcmp(argv[i], name) != 0 || i + 1 >= argc) return false;
+    value = std::atoi(argv[++i]);
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        int seed = static_cast<int>(opt.seed);
+        if (ParseInt(argc, argv, i, "--rounds", opt.rounds)) continue;
+        if (ParseInt(argc, argv, i, "--threads", opt.threads)) continue;
+        if (ParseInt(argc, argv, i, "--size", opt.size)) continue;
+        if (ParseInt(argc, argv, i, "--budget-us", opt.budgetUs)) continue;
+        if (ParseInt(argc, argv, i, "--depth", opt.depth)) continue;
+        if (ParseInt(argc, argv, i, "--seed", seed)) { opt.seed = static_cast<unsigned>(seed); continue; }
+        std::fprintf(stderr, "usage: %s [--rounds N] [--threads N] [--size N] [--budget-us N] [--depth N] [--seed N]\n", argv[0]);
+        return 2;
+    }
+    if (opt.threads <= 0) opt.threads = std::max(1u, std::thread::hardware_concurrency());
+    if (opt.size < 8) opt.size = 8;
+
+    std::vector<WorkerResult> results(opt.threads);
+    std::atomic<int> nextRound(0);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < opt.threads; ++t) {
+        workers.emplace_back([&, t]() {
+            TronBot bots[2] = {
+                TronBot(std::chrono::microseconds(opt.budgetUs), opt.depth),
+                TronBot(std::chrono::microseconds(opt.budgetUs), opt.depth),
+            };
+            WorkerResult& out = results[t];
+            out.latenciesNs.reserve(static_cast<size_t>(opt.rounds / opt.threads + 1) * opt.size * 4);
+            for (int r = nextRound++; r < opt.rounds; r = nextRound++)
+                PlayRound(opt, opt.seed + static_cast<unsigned>(r), bots, out);
+        });
+    }
+    for (auto& w : workers) w.join();
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    WorkerResult total;
+    for (auto& r : results) {
+        total.latenciesNs.insert(total.latenciesNs.end(), r.latenciesNs.begin(), r.latenciesNs.end());
+        total.ticks += r.ticks;
+        total.wins[0] += r.wins[0];
+        total.wins[1] += r.wins[1];
+        total.draws += r.draws;
+    }
+    std::vector<long long>& lat = total.latenciesNs;
+    std::sort(lat.begin(), lat.end());
+    auto pct = [&](double p) -> double {
+        if (lat.empty()) return 0.0;
+        size_t idx = static_cast<size_t>(p * (lat.size() - 1) + 0.5);
+        return lat[idx] / 1000.0;
+    };
+
+    std::printf("rounds      : %d on %d threads, %dx%d grid, budget %d us, depth %d\n",
+                opt.rounds, opt.threads, opt.size, opt.size, opt.budgetUs, opt.depth);
+    std::printf("elapsed     : %.3f s\n", elapsed);
+    std::printf("rounds/s    : %.1f\n", opt.rounds / elapsed);
+    std::printf("ticks/round : %.1f\n", opt.rounds ? static_cast<double>(total.ticks) / opt.rounds : 0.0);
+    std::printf("results     : bot A %d, bot B %d, draws %d\n", total.wins[0], total.wins[1], total.draws);
+    std::printf("decision us : p50 %.1f  p90 %.1f  p99 %.1f  max %.1f  (%zu decisions)\n",
+                pct(0.50), pct(0.90), pct(0.99), pct(1.0), lat.size());
+    return 0;
+}
@@ -0,0 +1,57 @@
+#ifndef ALLOC_TRACKER_H
+#define ALLOC_TRACKER_H
+
+#include <cstddef>
+#include <iosfwd>
+
+// Heap allocation counts per frame, split by the part of the frame that made
+// them. Opt-in: the global operator new/delete hooks are only compiled with
+// DUCKHUNT_TRACK_ALLOCS (make TRACK_ALLOCS=1). Without it the scope guards
+// still compile but nothing is counted and enabled() returns false.
+//
+// Scopes are per thread; allocations made on other threads (audio loading,
+// SFML's streaming thread) land in Other.
+class AllocTracker {
+public:
+    enum Scope { Other, Input, Update, Render, Spawn, ScopeCount };
+
+    struct Counts {
+        unsigned long long allocs = 0;
+        unsigned long long frees = 0;
+        unsigned long long bytes = 0;
+    };
+
+    // Attribute allocations on this thread to a scope until destroyed
+    class ScopeGuard {
+    public:
+        explicit ScopeGuard(Scope scope);
+        ~ScopeGuard();
+        ScopeGuard(const ScopeGuard&) = delete;
+        ScopeGuard& operator=(const ScopeGuard&) = delete;
+
+    private:
+        Scope previous_;
+    };
+
+    static bool enabled();
+    static const char* scopeName(Scope scope);
+
+    // Frame boundaries: endFrame() snapshots the counts since beginFrame()
+    static void beginFrame();
+    static void endFrame();
+
+    static const Counts& lastFrame(Scope scope);
+    // Totals since resetTotals(), and how many frames allocated in each scope
+    static const Counts& total(Scope scope);
+    static unsigned long long framesAllocating(Scope scope);
+    static unsigned long long frames();
+    static void resetTotals();
+
+    static void printSummary(std::ostream& out);
+
+    // Called by the operator new/delete hooks
+    static void recordAlloc(std::size_t bytes);
+    static void recordFree();
+};
+
+#endif // ALLOC_TRACKER_H
@@ -0,0 +1,132 @@
+#ifndef ANIMATION_HPP
+#define ANIMATION_HPP
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Sprite-sheet animation driven by one shared clock.
+//
+// Clips are read from a text file, one clip per line:
+//
+//     # name       frame_s  loop  x   y    w   h   frames  step_x  step_y
+//     pikachu_run  0.1      1     17  133  64  36  4       64      0
+//
+// Frame i uses the rect (x + i*step_x, y + i*step_y, w, h). Rects are
+// computed once at load time. Animated objects hold an Animator (a clip
+// pointer and a phase offset) and read the frame from the shared
+// AnimationClock, so there is no sf::Clock per object.
+
+struct AnimationClip {
+    std::string name;
+    float frameTime = 0.1f;      // seconds per frame
+    bool loop = true;
+    std::vector<sf::IntRect> frames;
+
+    float duration() const { return frameTime * static_cast<float>(frames.size()); }
+};
+
+// One tick for every animation. Advance it once per frame with the frame's dt.
+class AnimationClock {
+public:
+    void advance(float dt) { time_ += dt; }
+    double time() const { return time_; }
+
+    static AnimationClock& global() {
+        static AnimationClock clock;
+        return clock;
+    }
+
+private:
+    double time_ = 0.0;
+};
+
+class AnimationLibrary {
+public:
+    // Returns false if the file can't be opened; malformed lines are skipped with a warning
+    bool loadFromFile(const std::string& path) {
+        std::ifstream in(path);
+        if (!in) {
+            std::cerr << "Warning: could not open animation clips '" << path << "'\n";
+            return false;
+        }
+        std::string line;
+        int lineNo = 0;
+        while (std::getline(in, line)) {
+            ++lineNo;
+            std::size_t hash = line.find('#');
+            if (hash != std::string::npos) line.erase(hash);
+            std::istringstream fields(line);
+            AnimationClip clip;
+            int loop = 1, x = 0, y = 0, w = 0, h = 0, count = 0, stepX = 0, stepY = 0;
+            if (!(fields >> clip.name)) continue; // blank or comment
+            if (!(fields >> clip.frameTime >> loop >> x >> y >> w >> h >> count >> stepX >> stepY) ||
+                count <= 0 || clip.frameTime <= 0.f) {
+                std::cerr << "Warning: bad animation clip at " << path << ":" << lineNo << "\n";
+                continue;
+            }
+            clip.loop = loop != 0;
+            clip.frames.reserve(count);
+            for (int i = 0; i < count; ++i)
+                clip.frames.push_back(sf::IntRect(x + i * stepX, y + i * stepY, w, h));
+            clips_[clip.name] = clip;
+        }
+        return true;
+    }
+
+    // nullptr when the clip does not exist. Pointers stay valid while the library lives.
+    const AnimationClip* find(const std::string& name) const {
+        auto it = clips_.find(name);
+        return it == clips_.end() ? nullptr : &it->second;
+    }
+
+private:
+    std::map<std::string, AnimationClip> clips_;
+};
+
+// Per-object animation state: which clip and where in it this object starts.
+class Animator {
+public:
+    explicit Animator(const AnimationClip* clip = nullptr, float phase = 0.f) : clip_(clip), phase_(phase) {}
+
+    void setClip(const AnimationClip* clip, float phase = 0.f) {
+        clip_ = clip;
+        phase_ = phase;
+        lastFrame_ = -1;
+    }
+
+    const AnimationClip* clip() const { return clip_; }
+
+    int frameAt(double time) const {
+        if (!clip_ || clip_->frames.empty()) return 0;
+        const int n = static_cast<int>(clip_->frames.size());
+        int frame = static_cast<int>(std::floor((time + phase_) / clip_->frameTime));
+        if (!clip_->loop) return frame < 0 ? 0 : (frame >= n ? n - 1 : frame);
+        frame %= n;
+        return frame < 0 ? frame + n : frame;
+    }
+
+    // Set the sprite's texture rect for the current time. The sprite is only
+    // touched when the frame actually changes.
+    void apply(sf::Sprite& sprite, const AnimationClock& clock = AnimationClock::global()) {
+        if (!clip_ || clip_->frames.empty()) return;
+        int frame = frameAt(clock.time());
+        if (frame == lastFrame_) return;
+        lastFrame_ = frame;
+        sprite.setTextureRect(clip_->frames[frame]);
+    }
+
+private:
+    const AnimationClip* clip_;
+    float phase_;
+    int lastFrame_ = -1;
+};
+
+#endif // ANIMATION_HPP
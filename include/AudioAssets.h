@@ -0,0 +1,108 @@
+#ifndef AUDIO_ASSETS_H
+#define AUDIO_ASSETS_H
+
+#include <SFML/Audio.hpp>
+#include <atomic>
+#include <cstddef>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "MemoryLedger.h"
+
+// Read-only view of a whole file mapped into memory (mmap / MapViewOfFile).
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    const void* data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+private:
+    void* data_ = nullptr;
+    std::size_t size_ = 0;
+#ifdef _WIN32
+    void* file_ = nullptr;
+    void* mapping_ = nullptr;
+#endif
+};
+
+// Audio files used by the game, each loaded in one of two modes:
+//  - Decoded: the whole clip is decoded to 16-bit PCM into an sf::SoundBuffer
+//    at load time. Costs decode time and sampleCount * 2 bytes of RAM, but
+//    playing it is free. Meant for short, frequent effects.
+//  - Streamed: the compressed file is memory-mapped and played with
+//    sf::Music::openFromMemory, so only the stream's small decode buffer is
+//    resident and the file is never re-read through stdio. Meant for long
+//    tracks.
+//
+// Loading runs on a worker thread started by startLoading(); the game keeps
+// drawing meanwhile and calls wait() before it needs the assets. Every asset
+// records how long it took and how much memory it holds, see printReport().
+class AudioAssets {
+public:
+    enum class Mode { Decoded, Streamed };
+
+    struct Report {
+        std::string name;
+        std::string path;
+        Mode mode = Mode::Decoded;
+        bool loaded = false;
+        double loadMs = 0.0;        // decode (Decoded) or map + header parse (Streamed)
+        std::size_t pcmBytes = 0;   // decoded samples held in RAM
+        std::size_t mappedBytes = 0; // compressed file mapped for streaming
+        float seconds = 0.f;        // clip duration
+    };
+
+    AudioAssets() = default;
+    ~AudioAssets();
+    AudioAssets(const AudioAssets&) = delete;
+    AudioAssets& operator=(const AudioAssets&) = delete;
+
+    // Register an asset. Must be called before startLoading().
+    void add(const std::string& name, const std::string& path, Mode mode);
+
+    // Load every registered asset on a worker thread
+    void startLoading();
+    bool ready() const { return done_.load(); }
+    // Block until the worker has finished (no-op if it already has)
+    void wait();
+
+    // Decoded clip, or nullptr if missing / not loaded / not Decoded
+    const sf::SoundBuffer* sound(const std::string& name) const;
+    // Open a Streamed asset on the given music object. Returns false if missing.
+    bool openMusic(const std::string& name, sf::Music& music) const;
+
+    const std::vector<Report>& reports() const { return reportsCache_; }
+    std::size_t totalPcmBytes() const;
+    std::size_t totalMappedBytes() const;
+    void printReport(std::ostream& out) const;
+
+private:
+    struct Entry {
+        explicit Entry(const std::string& name) : memory(MemoryLedger::Audio, name) {}
+        Report report;
+        sf::SoundBuffer buffer;
+        MappedFile mapped;
+        MemoryLedger::Account memory; // pcm + mapped bytes, set by loadEntry()
+    };
+
+    void loadAll();
+    static void loadEntry(Entry& e);
+    const Entry* find(const std::string& name) const;
+
+    std::vector<std::unique_ptr<Entry>> entries_;
+    std::vector<Report> reportsCache_;
+    std::thread worker_;
+    std::atomic<bool> done_{false};
+};
+
+#endif // AUDIO_ASSETS_H
@@ -0,0 +1,59 @@
+#ifndef AUDIO_ENGINE_H
+#define AUDIO_ENGINE_H
+
+#include <SFML/Audio.hpp>
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include "MemoryLedger.h"
+
+class AudioAssets;
+
+// Sound effects the game can trigger
+enum class Sfx { Shot, Quack, Fall, Count };
+
+// Short sound effects played from a fixed pool of voices.
+//
+// The effects are decoded by AudioAssets (see registerAssets) and bound in
+// load(); play() never touches the disk or the heap. Each effect owns a
+// fixed slice of the pool with its buffer bound once at load time (binding
+// a buffer to an sf::Sound inserts into a std::set inside SFML 2). When
+// every voice of an effect is busy, the one that started first is restarted.
+class AudioEngine {
+public:
+    static const std::size_t VOICES = 16;
+
+    AudioEngine();
+
+    // Queue the effect files in assets/sounds as Decoded assets
+    static void registerAssets(AudioAssets& assets);
+
+    // Bind the decoded effects to the voice pool once the assets have
+    // loaded. Missing files get a generated fallback so the game always has
+    // feedback. Call once at startup.
+    void load(const AudioAssets& assets);
+
+    // Trigger an effect. volume 0..100, pitch 1 = unchanged.
+    void play(Sfx id, float volume = 100.f, float pitch = 1.f);
+
+    void setMasterVolume(float volume) { masterVolume_ = volume; }
+
+private:
+    struct Group {
+        std::size_t first = 0; // first voice in voices_
+        std::size_t count = 0;
+    };
+
+    const sf::SoundBuffer& generate(Sfx id);
+
+    std::array<sf::SoundBuffer, static_cast<std::size_t>(Sfx::Count)> generated_; // fallbacks only
+    MemoryLedger::Account generatedMemory_{MemoryLedger::Audio, "generated effects"};
+    std::array<Group, static_cast<std::size_t>(Sfx::Count)> groups_;
+    std::array<sf::Sound, VOICES> voices_;
+    std::array<std::uint64_t, VOICES> startedAt_{}; // play() counter value when each voice started
+    std::uint64_t playCounter_ = 0;
+    float masterVolume_ = 100.f;
+};
+
+#endif // AUDIO_ENGINE_H
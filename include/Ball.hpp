@@ -1,34 +1,56 @@
+#ifndef BALL_HPP
+#define BALL_HPP
+
+#include <SFML/Graphics.hpp>
 #include <chipmunk/chipmunk.h>
 
+// A single Chipmunk ball. For many balls prefer BallPool (BallPool.hpp),
+// which keeps them in one allocation and draws them in one batch.
 class Ball {
 public:
-    Ball(cpSpace* space, float radius, float mass, const cpVect& position) {
+    Ball(cpSpace* space, float radius, float mass, const cpVect& position)
+        : space(space), radius(radius), ballShape(radius) {
         cpFloat moment = cpMomentForCircle(mass, 0, radius, cpvzero);
         body = cpSpaceAddBody(space, cpBodyNew(mass, moment));
         cpBodySetPosition(body, position);
         shape = cpSpaceAddShape(space, cpCircleShapeNew(body, radius, cpvzero));
         cpShapeSetFriction(shape, 0.7);
+
+        ballShape.setOrigin(radius, radius);
+        ballShape.setFillColor(sf::Color::Red);
     }
 
-    sf::CircleShape GetShape() {
-        sf::CircleShape ballShape(20.0);
+    // The shape is built once; this only moves it to the body position
+    const sf::CircleShape& GetShape() {
         cpVect ballPosition = cpBodyGetPosition(body);
         ballShape.setPosition(ballPosition.x, ballPosition.y);
-        ballShape.setFillColor(sf::Color::Red);
         return ballShape;
     }
 
     ~Ball() {
+        cpSpaceRemoveShape(space, shape);
+        cpSpaceRemoveBody(space, body);
         cpShapeFree(shape);
         cpBodyFree(body);
     }
 
+    Ball(const Ball&) = delete;
+    Ball& operator=(const Ball&) = delete;
+
     cpBody* getBody() {
         return body;
     }
 
+    float getRadius() const {
+        return radius;
+    }
+
 private:
-    int radius;
+    cpSpace* space;
+    float radius;
     cpBody* body;
     cpShape* shape;
-};
\ No newline at end of file
+    sf::CircleShape ballShape;
+};
+
+#endif // BALL_HPP
@@ -0,0 +1,182 @@
+#ifndef BALL_POOL_HPP
+#define BALL_POOL_HPP
+
+#include <SFML/Graphics.hpp>
+#include <chipmunk/chipmunk.h>
+#include <chipmunk/chipmunk_structs.h> // struct sizes, to preallocate bodies and shapes
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Fixed-capacity pool of Chipmunk balls that share one radius and mass.
+// Bodies and shapes live in two contiguous arrays allocated up front
+// (cpBodyInit / cpCircleShapeInit instead of cpBodyNew / cpCircleShapeNew),
+// so spawning never touches the heap and the storage never moves while the
+// space holds pointers into it.
+//
+// Add and remove must not be called from inside cpSpaceStep.
+class BallPool {
+public:
+    typedef std::uint32_t Handle;
+    static const Handle INVALID = 0xFFFFFFFFu;
+
+    BallPool(cpSpace* space, std::size_t capacity, float radius, float mass)
+        : space(space), cap(capacity), radius(radius), mass(mass),
+          bodies(new cpBody[capacity]), shapes(new cpCircleShape[capacity]),
+          denseOf(capacity, INVALID) {
+        freeSlots.reserve(capacity);
+        for (std::size_t i = capacity; i-- > 0;) freeSlots.push_back(static_cast<Handle>(i));
+        dense.reserve(capacity);
+        points.reserve(capacity);
+    }
+
+    ~BallPool() {
+        clear();
+    }
+
+    BallPool(const BallPool&) = delete;
+    BallPool& operator=(const BallPool&) = delete;
+
+    // Spawn balls at the given positions. Stops when the pool is full and
+    // returns how many were added; their handles are appended to `out`.
+    std::size_t addBatch(const cpVect* positions, std::size_t count, std::vector<Handle>* out = nullptr) {
+        cpFloat moment = cpMomentForCircle(mass, 0, radius, cpvzero);
+        std::size_t added = 0;
+        for (; added < count && !freeSlots.empty(); ++added) {
+            Handle h = freeSlots.back();
+            freeSlots.pop_back();
+
+            cpBody* body = cpBodyInit(&bodies[h], mass, moment);
+            cpBodySetPosition(body, positions[added]);
+            cpShape* shape = reinterpret_cast<cpShape*>(cpCircleShapeInit(&shapes[h], body, radius, cpvzero));
+            cpShapeSetFriction(shape, 0.7);
+            cpSpaceAddBody(space, body);
+            cpSpaceAddShape(space, shape);
+
+            denseOf[h] = static_cast<Handle>(dense.size());
+            dense.push_back(h);
+            points.push_back(sf::Vector2f(static_cast<float>(positions[added].x), static_cast<float>(positions[added].y)));
+            if (out) out->push_back(h);
+        }
+        return added;
+    }
+
+    // Remove balls by handle; unknown or already removed handles are ignored
+    void removeBatch(const Handle* handles, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) remove(handles[i]);
+    }
+
+    void remove(Handle h) {
+        if (h >= cap || denseOf[h] == INVALID) return;
+        cpShape* shape = reinterpret_cast<cpShape*>(&shapes[h]);
+        cpSpaceRemoveShape(space, shape);
+        cpSpaceRemoveBody(space, &bodies[h]);
+        cpShapeDestroy(shape);
+        cpBodyDestroy(&bodies[h]);
+
+        // keep the live list dense: move the last entry into the hole
+        Handle at = denseOf[h];
+        Handle last = dense.back();
+        dense[at] = last;
+        points[at] = points.back();
+        denseOf[last] = at;
+        dense.pop_back();
+        points.pop_back();
+        denseOf[h] = INVALID;
+        freeSlots.push_back(h);
+    }
+
+    void clear() {
+        while (!dense.empty()) remove(dense.back());
+    }
+
+    // Copy body positions into positions(); call once after each cpSpaceStep
+    void syncPositions() {
+        for (std::size_t i = 0; i < dense.size(); ++i) {
+            cpVect p = cpBodyGetPosition(&bodies[dense[i]]);
+            points[i] = sf::Vector2f(static_cast<float>(p.x), static_cast<float>(p.y));
+        }
+    }
+
+    // Centres of the live balls, in the same order as handles()
+    const std::vector<sf::Vector2f>& positions() const { return points; }
+    const std::vector<Handle>& handles() const { return dense; }
+
+    cpBody* body(Handle h) { return h < cap && denseOf[h] != INVALID ? &bodies[h] : nullptr; }
+
+    std::size_t size() const { return dense.size(); }
+    std::size_t capacity() const { return cap; }
+    float getRadius() const { return radius; }
+
+private:
+    cpSpace* space;
+    std::size_t cap;
+    float radius;
+    float mass;
+
+    std::unique_ptr<cpBody[]> bodies;
+    std::unique_ptr<cpCircleShape[]> shapes;
+    std::vector<Handle> freeSlots;
+
+    std::vector<Handle> dense;        // live handles, packed
+    std::vector<Handle> denseOf;      // handle -> index in dense
+    std::vector<sf::Vector2f> points; // positions, parallel to dense
+};
+
+// Draws every ball of a pool as textured quads from one vertex array, in a
+// single draw call. The circle texture is rendered once at construction.
+class BallBatch : public sf::Drawable {
+public:
+    explicit BallBatch(float radius, sf::Color color = sf::Color::Red) : radius(radius) {
+        unsigned size = static_cast<unsigned>(radius * 2.f + 2.f);
+        sf::RenderTexture rt;
+        if (rt.create(size, size)) {
+            rt.clear(sf::Color::Transparent);
+            sf::CircleShape circle(radius);
+            circle.setPosition(1.f, 1.f);
+            circle.setFillColor(sf::Color::White);
+            rt.draw(circle);
+            rt.display();
+            texture = rt.getTexture();
+            texture.setSmooth(true);
+        }
+        tint = color;
+        vertices.setPrimitiveType(sf::Triangles);
+    }
+
+    // Rebuild the vertex array from the pool; the array only grows
+    void update(const BallPool& pool) {
+        const std::vector<sf::Vector2f>& pos = pool.positions();
+        if (vertices.getVertexCount() < pos.size() * 6) vertices.resize(pos.size() * 6);
+        count = pos.size() * 6;
+
+        const float r = radius + 1.f;
+        const sf::Vector2f ts(static_cast<float>(texture.getSize().x), static_cast<float>(texture.getSize().y));
+        for (std::size_t i = 0; i < pos.size(); ++i) {
+            sf::Vertex* q = &vertices[i * 6];
+            const sf::Vector2f c = pos[i];
+            q[0] = sf::Vertex(sf::Vector2f(c.x - r, c.y - r), tint, sf::Vector2f(0.f, 0.f));
+            q[1] = sf::Vertex(sf::Vector2f(c.x + r, c.y - r), tint, sf::Vector2f(ts.x, 0.f));
+            q[2] = sf::Vertex(sf::Vector2f(c.x + r, c.y + r), tint, sf::Vector2f(ts.x, ts.y));
+            q[3] = q[0];
+            q[4] = q[2];
+            q[5] = sf::Vertex(sf::Vector2f(c.x - r, c.y + r), tint, sf::Vector2f(0.f, ts.y));
+        }
+    }
+
+private:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override {
+        if (count == 0) return;
+        states.texture = &texture;
+        target.draw(&vertices[0], count, sf::Triangles, states);
+    }
+
+    float radius;
+    sf::Color tint;
+    sf::Texture texture;
+    sf::VertexArray vertices;
+    std::size_t count = 0;
+};
+
+#endif // BALL_POOL_HPP
@@ -0,0 +1,83 @@
+#ifndef BOX2D_WORLD_HPP
+#define BOX2D_WORLD_HPP
+
+#include <SFML/System/Vector2.hpp>
+#include <Box2D/Box2D.h>
+
+// Thin wrapper over b2World that keeps SFML code in pixels and Box2D in
+// meters, and steps the simulation at a fixed rate no matter how long the
+// rendered frame took.
+//
+// Box2D is tuned for objects between 0.1 and 10 m, so pick pixelsPerMeter so
+// that the typical sprite lands in that range (a 50 px ball at 50 px/m is 1 m).
+class Box2DWorld {
+public:
+    struct Settings {
+        float pixelsPerMeter = 50.f;
+        float timeStep = 1.f / 60.f;   // fixed step in seconds
+        int subSteps = 1;              // Box2D steps per fixed step (each timeStep / subSteps)
+        int velocityIterations = 8;
+        int positionIterations = 3;
+        int maxStepsPerUpdate = 5;     // drop time instead of spiralling after a long frame
+    };
+
+    // gravity in px/s^2
+    explicit Box2DWorld(const sf::Vector2f& gravity) : Box2DWorld(gravity, Settings()) {}
+
+    Box2DWorld(const sf::Vector2f& gravity, const Settings& settings)
+        : settings_(settings),
+          world_(b2Vec2(gravity.x / settings.pixelsPerMeter, gravity.y / settings.pixelsPerMeter)) {
+        if (settings_.subSteps < 1) settings_.subSteps = 1;
+        world_.SetAllowSleeping(true);
+        // forces are cleared once per fixed step, after all of its sub-steps (see update())
+        world_.SetAutoClearForces(false);
+    }
+
+    Box2DWorld(const Box2DWorld&) = delete;
+    Box2DWorld& operator=(const Box2DWorld&) = delete;
+
+    b2World& world() { return world_; }
+    const b2World& world() const { return world_; }
+    const Settings& settings() const { return settings_; }
+
+    float toMeters(float px) const { return px / settings_.pixelsPerMeter; }
+    float toPixels(float m) const { return m * settings_.pixelsPerMeter; }
+    b2Vec2 toMeters(const sf::Vector2f& px) const { return b2Vec2(toMeters(px.x), toMeters(px.y)); }
+    sf::Vector2f toPixels(const b2Vec2& m) const { return sf::Vector2f(toPixels(m.x), toPixels(m.y)); }
+
+    // Advance by the real elapsed time. Returns the number of fixed steps taken.
+    int update(float dt) { return update(dt, [] {}); }
+
+    // Same, calling beforeStep() ahead of every fixed step. Continuous forces
+    // must be applied here: they act on every sub-step of that fixed step and
+    // are cleared after it, so their effect does not depend on subSteps.
+    template <class F>
+    int update(float dt, F beforeStep) {
+        accumulator_ += dt;
+        int steps = 0;
+        while (accumulator_ >= settings_.timeStep) {
+            if (steps == settings_.maxStepsPerUpdate) {
+                accumulator_ = 0.f;
+                break;
+            }
+            beforeStep();
+            const float h = settings_.timeStep / settings_.subSteps;
+            for (int i = 0; i < settings_.subSteps; ++i)
+                world_.Step(h, settings_.velocityIterations, settings_.positionIterations);
+            world_.ClearForces();
+            accumulator_ -= settings_.timeStep;
+            ++steps;
+        }
+        return steps;
+    }
+
+    // Fraction of a fixed step left in the accumulator, for render interpolation
+    float alpha() const { return accumulator_ / settings_.timeStep; }
+
+private:
+    Settings settings_;
+    b2World world_;
+    float accumulator_ = 0.f;
+};
+
+#endif // BOX2D_WORLD_HPP
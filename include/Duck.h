@@ -4,36 +4,76 @@
 #include <SFML/Graphics.hpp>
 #include <string>
 #include <memory>
+#include "Animation.hpp"
+#include "HitMask.h"
+#include "MemoryLedger.h"
+#include "RenderSnapshot.h"
+
+class DuckPhysics;
+class b2Body;
 
 class Duck {
 public:
-    // Constructor: position (start), windowSize for bounds check, optional texture path
-    Duck(const sf::Vector2f& startPos, const sf::Vector2u& windowSize, const std::string& texturePath = "assets/images/duck.png");
+    // Constructor: position (start), windowSize for bounds check, optional texture path,
+    // optional wing-flap clip (its frames are built from the texture at load time)
+    Duck(const sf::Vector2f& startPos, const sf::Vector2u& windowSize, const std::string& texturePath = "assets/images/duck.png",
+         const AnimationClip* flapClip = nullptr);
     ~Duck();
 
     // Update duck logic (dt seconds elapsed)
     void update(float dt);
 
     // Draw the duck to the provided window
-    void draw(sf::RenderWindow& window) const;
+    void draw(sf::RenderTarget& target) const;
+    // What draw() would draw, for a render snapshot; false if nothing
+    bool snapshot(RenderSnapshot::Sprite& out) const;
 
     // Return global bounding box (for hit tests)
     sf::FloatRect getBounds() const;
 
-    // Mark as hit / shot (starts falling)
-    void onShot();
+    // Pixel-accurate hit test: the bounding box first, then one lookup in the
+    // alpha mask of the current frame. Placeholder ducks use the box alone.
+    bool hitTest(const sf::Vector2f& point) const;
+
+    // Mark as hit / shot (starts falling). With a physics world the duck
+    // becomes a Box2D body that tumbles onto the grass; otherwise it just falls.
+    void onShot(DuckPhysics* physics = nullptr);
+
+    // Simulation detail. A Coarse duck only advances its flight path (x and
+    // the sine phase); sprite, animation and bounds are brought up to date
+    // when it goes back to Full. Falling ducks are always Full.
+    enum class Lod { Full, Coarse };
+    void setLod(Lod lod);
+    Lod lod() const { return lod_; }
+
+    // Coarse when the duck is more than margin px outside the visible area
+    void updateLod(const sf::FloatRect& visible, float margin = 128.f);
+
+    // Culling test before drawing
+    bool isVisible(const sf::FloatRect& visible) const { return isAlive_ && getBounds().intersects(visible); }
 
     // Accessors
     bool isAlive() const { return isAlive_; }
     bool isFalling() const { return isFalling_; }
-    sf::Vector2f getPosition() const { return sprite_ ? sprite_->getPosition() : sf::Vector2f(0.f,0.f); }
+    sf::Vector2f getPosition() const;
+
+    // Texture preparation done at load: colour-key the bright background
+    // to transparent and flip the image so the duck faces right
+    static sf::Image keyAndFlip(const sf::Image& source);
 
 private:
-    // Visual
-    sf::Texture texture_;
+    // Visual: texture and hit mask are shared by every duck using the same image and clip
+    struct Art {
+        explicit Art(const std::string& name) : memory(MemoryLedger::Ducks, name) {}
+        sf::Texture texture;
+        HitMask mask;
+        MemoryLedger::Account memory;
+    };
+    std::shared_ptr<const Art> art_;
     std::unique_ptr<sf::Sprite> sprite_;
     sf::RectangleShape placeholder_;
     bool hasTexture_ = false;
+    Animator flap_; // frame comes from the shared AnimationClock, phase is random per duck
 
     // Movement
     float vx_; // horizontal velocity (px/s)
@@ -47,11 +87,25 @@ private:
     bool isAlive_ = true;
     bool isFalling_ = false;
 
+    // Coarse simulation: x along the path and the half size of the box
+    // when it was entered (flying ducks do not rotate, so it stays valid)
+    Lod lod_ = Lod::Full;
+    float coarseX_ = 0.f;
+    sf::Vector2f halfSize_;
+
+    // Physics (only while falling / lying on the pile)
+    DuckPhysics* physics_ = nullptr;
+    b2Body* body_ = nullptr;
+    float restTime_ = 0.f; // seconds the body has been asleep
+
     // Bounds
     sf::Vector2u windowSize_;
 
     // Helpers
-    void ensureTextureLoaded(const std::string& path);
+    static std::shared_ptr<const Art> loadArt(const std::string& path, const AnimationClip* flapClip);
+    void ensureTextureLoaded(const std::string& path, const AnimationClip* flapClip);
+    void updateFromBody(float dt);
+    void releaseBody();
 };
 
 #endif // DUCK_H
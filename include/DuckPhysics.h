@@ -0,0 +1,46 @@
+#ifndef DUCK_PHYSICS_H
+#define DUCK_PHYSICS_H
+
+#include <SFML/System/Vector2.hpp>
+#include "Box2DWorld.hpp"
+
+// Box2D world for shot ducks. Ducks tumble, land on the grass and pile up;
+// bodies at rest go to sleep so a large pile costs almost nothing to step.
+// The world works in meters, everything in the public API is in pixels.
+class DuckPhysics {
+public:
+    static constexpr float PIXELS_PER_METER = 30.f; // a 32 px duck is about 1 m
+    static constexpr float TIME_STEP = 1.f / 60.f;
+
+    // fieldSize: play area in pixels, groundY: top of the grass in pixels
+    DuckPhysics(const sf::Vector2f& fieldSize, float groundY);
+    ~DuckPhysics();
+
+    DuckPhysics(const DuckPhysics&) = delete;
+    DuckPhysics& operator=(const DuckPhysics&) = delete;
+
+    // Create a dynamic box for a falling duck (position/velocity in px, px/s; angles in degrees)
+    b2Body* createDuckBody(const sf::Vector2f& position, const sf::Vector2f& halfSize, float angleDeg,
+                           const sf::Vector2f& velocity, float angularVelocityDeg);
+    void destroyBody(b2Body* body);
+
+    // Advance by dt seconds using fixed TIME_STEP sub-steps
+    void step(float dt);
+
+    // Seconds a duck stays on the pile after its body falls asleep (< 0 keeps it forever)
+    void setCorpseLifetime(float seconds) { corpseLifetime_ = seconds; }
+    float corpseLifetime() const { return corpseLifetime_; }
+
+    int bodyCount() const { return world_.world().GetBodyCount(); }
+    int awakeBodyCount() const;
+
+    float toMeters(float px) const { return world_.toMeters(px); }
+    sf::Vector2f toPixels(const b2Vec2& m) const { return world_.toPixels(m); }
+
+private:
+    Box2DWorld world_;
+    b2Body* ground_ = nullptr;
+    float corpseLifetime_ = 4.f;
+};
+
+#endif // DUCK_PHYSICS_H
@@ -0,0 +1,102 @@
+#ifndef DYNAMIC_RESOLUTION_H
+#define DYNAMIC_RESOLUTION_H
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+#include "MemoryLedger.h"
+
+// Renders the world into an offscreen texture whose resolution follows the
+// measured frame time, then upscales it into the window.
+//
+// The world has a fixed logical size. In the window it is letterboxed:
+// scaled uniformly to fit, centred, with black bars where the aspect ratio
+// does not match. The texture is created at the pixel size of that area;
+// each frame only its top-left scale x scale part is rendered (through the
+// view's viewport) and stretched over the area, so changing the scale never
+// reallocates anything. Only a window resize recreates the texture.
+//
+// SFML has no GPU timer queries. The frame time fed to endFrame() is the
+// time spent rendering and presenting, without the frame-rate limiter's
+// sleep: presenting blocks once the GPU falls behind, so that is where GPU
+// load shows up.
+class DynamicResolution {
+public:
+    struct Settings {
+        float targetMs = 14.f;      // frame time to hold, some headroom under 16.7 ms
+        float minScale = 0.5f;      // per axis, so a quarter of the pixels
+        float maxScale = 1.f;
+        float raiseBelow = 0.75f;   // raise the scale when under targetMs * raiseBelow
+        float raiseStep = 0.05f;
+        unsigned adjustEvery = 15;  // frames averaged for each decision
+        unsigned historySize = 240; // frame times kept for tuning
+    };
+
+    explicit DynamicResolution(const sf::Vector2f& worldSize) : DynamicResolution(worldSize, Settings()) {}
+    DynamicResolution(const sf::Vector2f& worldSize, const Settings& settings);
+
+    // Fit the world into a window of this size, (re)creating the texture if
+    // the letterbox area changed size. Returns false if no texture could be
+    // created; the world is then drawn straight into the window.
+    bool resize(const sf::Vector2u& windowSize);
+
+    // View of a world of this size letterboxed into a window of this size.
+    // Pure arithmetic: any thread can use it to map mouse positions.
+    static sf::View letterbox(const sf::Vector2f& worldSize, const sf::Vector2u& windowSize);
+
+    // World coordinates, letterboxed into the window. Set on the window so
+    // mouse positions map into the world and overlays are drawn at full
+    // resolution on top of the upscaled world.
+    const sf::View& windowView() const { return windowView_; }
+
+    // Start a frame: returns the target to draw the world into, cleared to color
+    sf::RenderTarget& beginScene(sf::RenderTarget& window, const sf::Color& color);
+    // Clear the window's bars and stretch the rendered part over the letterbox area
+    void present(sf::RenderTarget& window);
+    // Record a frame time; every adjustEvery frames the scale is adjusted
+    void endFrame(float frameMs);
+
+    // A fixed scale turns adjustment off (e.g. for reproducible offscreen runs)
+    void setScale(float scale);
+    void setAdaptive(bool adaptive) { adaptive_ = adaptive; }
+    float scale() const { return scale_; }
+    bool adaptive() const { return adaptive_; }
+    Settings& settings() { return settings_; }
+    const Settings& settings() const { return settings_; }
+    // Pixel size of the world as rendered this frame
+    sf::Vector2u renderSize() const { return renderSize_; }
+
+    // Frame-time history in ms, i = 0 is the oldest kept frame
+    std::size_t historyCount() const { return historyCount_; }
+    float history(std::size_t i) const;
+    // Mean of the last n frames (fewer if not that many were recorded)
+    float averageMs(std::size_t n) const;
+    unsigned scaleChanges() const { return scaleChanges_; }
+    void printSummary(std::ostream& out) const;
+
+private:
+    void updateRenderSize();
+
+    Settings settings_;
+    sf::Vector2f worldSize_;
+    sf::Vector2u areaSize_; // letterbox area in window pixels = texture size
+    sf::Vector2u renderSize_;
+    sf::View windowView_;
+    sf::View sceneView_;
+    sf::RenderTexture scene_;
+    sf::Sprite sprite_;
+    MemoryLedger::Account memory_{MemoryLedger::Render, "scene render texture"};
+    bool ok_ = false;
+    bool adaptive_ = true;
+    float scale_ = 1.f;
+
+    std::vector<float> history_; // ring buffer of historySize frame times
+    std::size_t historyNext_ = 0;
+    std::size_t historyCount_ = 0;
+    unsigned sinceAdjust_ = 0;
+    unsigned scaleChanges_ = 0;
+};
+
+#endif // DYNAMIC_RESOLUTION_H
@@ -6,64 +6,200 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <cstdint>
 #include "Duck.h"
+#include "DuckPhysics.h"
+#include "AudioAssets.h"
+#include "AudioEngine.h"
+#include "TextAtlas.h"
+#include "GameWindow.hpp"
+#include "ParticleSystem.h"
+#include "DynamicResolution.h"
+#include "StressTest.h"
+#include "SceneStack.hpp"
+#include "Telemetry.h"
+#include "RenderSnapshot.h"
+#include "RenderThread.h"
+#include "LatencyProbe.h"
+#include "MemoryLedger.h"
 
 class Game {
 public:
     Game(unsigned int width = 800, unsigned int height = 600, const std::string& title = "SHOOTING DUCKS");
+    // Render into the given backend instead of opening a window (e.g. OffscreenWindow)
+    Game(std::unique_ptr<RenderBackend> backend, const std::string& title = "SHOOTING DUCKS");
     ~Game();
 
     // Initialize resources. Returns false if initialization fails.
     bool init();
 
-    // Run the main loop
+    // Run the main loop until the window closes: instructions, rounds and
+    // game over screens all run inside it (see SceneStack.hpp)
     void run();
 
+    // Run a fixed number of frames with a fixed dt, as fast as possible.
+    // Returns the mean wall time per frame in ms (update + render + display).
+    double runFrames(int frames, float dt = 1.f / 60.f);
+
+    // Ramp the spawn rate until frames miss the budget (see StressTest.h).
+    // Runs on whatever backend the game has: real dt in a window, a fixed dt offscreen.
+    StressReport runStress(const StressSettings& settings = StressSettings());
+
+    // Session telemetry; open() it before run() to record the session
+    Telemetry& telemetry() { return telemetry_; }
+
+    // World render resolution: scale, frame-time history, tuning settings
+    DynamicResolution& resolution() { return resolution_; }
+
+    // Draw on a separate render thread during run() (see RenderThread.h).
+    // runFrames() and runStress() always draw on the calling thread.
+    void setRenderThread(bool enabled) { useRenderThread_ = enabled; }
+    // Window frame-rate limit (0 = none) and vsync; set before run()
+    void setFramePacing(unsigned framerateLimit, bool vsync);
+
+    // Measure click-to-display latency in run() and report it at the end
+    // (see LatencyProbe.h). With syntheticClicks > 0 the game also clicks
+    // by itself, a few times a second at ducks on screen, and quits once
+    // that many shots have been displayed.
+    void measureLatency(const std::string& reportPath = std::string(), int syntheticClicks = 0);
+
 private:
-    // Input, update, render
+    // Screens; defined in Game.cpp, they work on the game's state directly
+    class InstructionsScene;
+    class PlayingScene;
+    class GameOverScene;
+
+    // One frame: scene transitions, input, update, snapshot; drawn here or
+    // handed to the render thread
+    void frame(float dt);
     void handleInput();
+    bool keepRunning() const { return !closeRequested_ && window_->isOpen(); }
+    // The round: spawning, ducks, physics, particles, HUD (PlayingScene)
     void update(float dt);
-    void render();
+    void render(RenderSnapshot& frame);
+    void shoot(const sf::Vector2i& pixel);
+    // Latency measurement: click at the first duck on screen (or at the
+    // middle of a menu) as if the mouse had been pressed at the scheduled time
+    void syntheticClick();
+    std::string latencyLabel() const;
+    // Window resized: letterbox the world into the new size
+    void onResized(const sf::Vector2u& size);
+    // Draw a snapshot into the window and display it. Only touches resources
+    // the simulation does not change, so it may run on the render thread.
+    void draw(const RenderSnapshot& frame);
 
-    // Show game over screen
-    void ShowGameOver();
-    // Show instructions before starting the round
-    void ShowInstructions(float seconds = 7.f);
+    // Reset score, lives and ducks and switch to the round. Loaded resources
+    // are kept, so restarting after a game over is instant.
+    void startRound();
+    // Wait for the audio loader (once) and hand the sounds to the engine
+    void finishLoading();
 
     // Spawn helper
     void spawnDuck();
 
-    sf::RenderWindow window_;
+    // Memory accounting (see MemoryLedger.h): F3 or SIGUSR1 prints the
+    // ledger, F4 toggles the overlay. Pools are sampled twice a second.
+    void updateMemory(float dt);
+    void accountPools();
+
+    // Wall time of each phase of the last frame, in ms
+    struct PhaseTimes {
+        float input = 0.f;
+        float update = 0.f;
+        float render = 0.f;
+    };
+    PhaseTimes lastFrame_;
+
+    std::unique_ptr<RenderBackend> window_;
     unsigned int width_;
     unsigned int height_;
     std::string title_;
+    // Declared early so it is closed (and flushed) after everything that logs to it
+    Telemetry telemetry_;
+    // The world is drawn at an adaptive resolution and upscaled into the window.
+    // Belongs to whichever thread draws.
+    DynamicResolution resolution_;
+    sf::Vector2u drawnSize_;  // window size resolution_ was last resized for
+    // Simulation side of the letterbox: maps clicks and culls
+    sf::Vector2u windowSize_;
+    sf::View view_;
 
     // Game state
     int score_ = 0;
     int playerLives_ = 3;
+    int shownScore_ = -1; // values the HUD text currently shows
+    int shownLives_ = -1;
     bool gameOver_ = false;
+    int round_ = 0;
+    SceneStack scenes_;
+    std::unique_ptr<InstructionsScene> instructionsScene_;
+    std::unique_ptr<PlayingScene> playingScene_;
+    std::unique_ptr<GameOverScene> gameOverScene_;
+    // Box2D world for shot ducks; declared before ducks_ so it outlives their bodies
+    std::unique_ptr<DuckPhysics> physics_;
     std::vector<std::unique_ptr<Duck>> ducks_;
+    ParticleSystem particles_; // hit / miss feedback, fixed pool
 
     // Resources
-    sf::Font font_;
+    // Every screen's text lives in one atlas and is drawn in one call
+    TextAtlas text_;
     bool fontLoaded_ = false;
-    std::unique_ptr<sf::Text> scoreText_;
-    std::unique_ptr<sf::Text> livesText_;
-    std::unique_ptr<sf::Text> instructionsText_;
-    std::unique_ptr<sf::Text> titleText_;
-    std::unique_ptr<sf::Text> loadingText_;
-    sf::Music duckMusic;
+    TextAtlas::TextId scoreText_ = 0;
+    TextAtlas::TextId livesText_ = 0;
+    TextAtlas::TextId instructionsText_ = 0;
+    TextAtlas::TextId titleText_ = 0;
+    TextAtlas::TextId loadingText_ = 0;
+    TextAtlas::TextId gameOverText_ = 0;
+    TextAtlas::TextId restartText_ = 0;
+    TextAtlas::TextId memoryText_ = 0;
+    // Audio files, loaded on a worker thread while the instructions are shown
+    AudioAssets audioAssets_;
+    sf::Music duckMusic; // streamed from audioAssets_' mapped file, so declared after it
+    AudioEngine audio_;  // shot / hit effects
+    bool audioLoaded_ = false;
+    bool musicOpen_ = false;
+    AnimationLibrary animations_;
+    sf::RectangleShape grass_;
+    // Reused to draw snapshot ducks
+    sf::Sprite duckSprite_;
+    sf::RectangleShape duckBox_;
     // Background pond image for instruction screen
     sf::Texture pondTexture_;
     sf::Sprite pondSprite_;
     bool pondLoaded_ = false;
 
+    MemoryLedger::Account pondMemory_{MemoryLedger::Scenery, "pond texture"};
+    MemoryLedger::Account duckPool_{MemoryLedger::Ducks, "duck pool"};
+    MemoryLedger::Account snapshotMemory_{MemoryLedger::Render, "render snapshots"};
+    bool showMemory_ = false;
+    float memoryRefresh_ = 0.f;
+
     // Timing
     sf::Clock clock_;
     float spawnTimer_ = 0.f;
     float spawnInterval_ = 2.5f; // seconds
 
     bool running_ = false;
+    // Close asked for (window X, Escape); the render thread is stopped before the window closes
+    bool closeRequested_ = false;
+
+    // Frames handed from the simulation to the renderer
+    RenderSnapshot snapshot_; // single-threaded mode
+    std::uint64_t tick_ = 0;
+    bool useRenderThread_ = false;
+    unsigned framerateLimit_ = 60;
+    bool vsync_ = false;
+
+    // Click-to-display latency; clickArrived_ tags the click being handled
+    LatencyProbe latency_;
+    bool measureLatency_ = false;
+    std::string latencyReport_;
+    int syntheticClicks_ = 0;
+    LatencyProbe::Clock::time_point clickArrived_;
+    LatencyProbe::Clock::time_point nextClick_;
+
+    // Declared last: stopped before anything it draws is destroyed
+    RenderThread renderThread_;
 };
 
 #endif // GAME_H
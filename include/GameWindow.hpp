@@ -1,37 +1,142 @@
-class GameWindow {
+#ifndef GAME_WINDOW_HPP
+#define GAME_WINDOW_HPP
+
+#include <SFML/Graphics.hpp>
+
+#include <cstdio>
+#include <deque>
+#include <string>
+
+// Where a frame goes. The game draws into target() and calls display() once
+// per frame; the backend decides whether that means presenting a window or
+// finishing an offscreen frame.
+class RenderBackend {
 public:
-    GameWindow(int width, int height, const std::string& title) {
-        window.create(sf::VideoMode(width, height), title);
-    }
+    virtual ~RenderBackend() = default;
 
-    bool isOpen() {
-        return window.isOpen();
-    }
+    virtual sf::RenderTarget& target() = 0;
+    virtual bool isOpen() const = 0;
+    virtual void close() = 0;
+    virtual bool pollEvent(sf::Event& event) = 0;
+    virtual void display() = 0;
+    virtual sf::Vector2u getSize() const = 0;
 
-    void close() {
-        window.close();
+    // False for backends with nobody watching: callers skip real-time waits
+    // (splash screens, sleeps) and audio there
+    virtual bool isInteractive() const = 0;
+
+    // Block until every displayed frame has actually been rendered
+    virtual void finish() {}
+
+    // Make the target's OpenGL context current on the calling thread (or
+    // release it), so another thread can take over the drawing
+    virtual bool setActive(bool active) = 0;
+
+    // Wait out the rest of the frame for the frame-rate limit. Called after
+    // display(), so frame-time measurements can leave the wait out.
+    virtual void pace() {}
+    // Frame-rate limit applied by pace() (0 = none) and vertical sync;
+    // backends without a screen ignore both
+    virtual void setFramerateLimit(unsigned) {}
+    virtual void setVerticalSync(bool) {}
+
+    void clear(const sf::Color& color = sf::Color::Black) { target().clear(color); }
+    void draw(const sf::Drawable& drawable, const sf::RenderStates& states = sf::RenderStates::Default) {
+        target().draw(drawable, states);
     }
+};
 
-    void clear() {
-        window.clear();
+// On-screen backend
+class GameWindow : public RenderBackend {
+public:
+    // The frame-rate limit is applied in pace() rather than by SFML inside
+    // display(), where it could not be told apart from the GPU catching up
+    GameWindow(unsigned width, unsigned height, const std::string& title, unsigned framerateLimit = 60)
+        : frameTime(framerateLimit ? sf::seconds(1.f / framerateLimit) : sf::Time::Zero) {
+        window.create(sf::VideoMode(width, height), title);
     }
 
-    void display() {
-        window.display();
+    sf::RenderTarget& target() override { return window; }
+    bool isOpen() const override { return window.isOpen(); }
+    void close() override { window.close(); }
+    bool pollEvent(sf::Event& event) override { return window.pollEvent(event); }
+    void display() override { window.display(); }
+    sf::Vector2u getSize() const override { return window.getSize(); }
+    bool isInteractive() const override { return true; }
+    bool setActive(bool active) override { return window.setActive(active); }
+    void pace() override {
+        if (frameTime == sf::Time::Zero) return;
+        sf::sleep(frameTime - pacer.getElapsedTime());
+        pacer.restart();
     }
+    void setFramerateLimit(unsigned limit) override { frameTime = limit ? sf::seconds(1.f / limit) : sf::Time::Zero; }
+    void setVerticalSync(bool enabled) override { window.setVerticalSyncEnabled(enabled); }
+
+private:
+    sf::RenderWindow window;
+    sf::Time frameTime;
+    sf::Clock pacer;
+};
 
-    void draw(sf::Shape& shape) {
-        window.draw(shape);
+// Offscreen backend: frames are rendered into an sf::RenderTexture, with no
+// window, vsync or compositor involved, and can be written out as PNGs
+// (frame_00001.png, ...) for golden-image comparisons. Input comes only
+// from events queued with pushEvent().
+//
+// The render texture still needs an OpenGL context; on a CI machine without
+// a display run it under a virtual X server (e.g. xvfb-run).
+class OffscreenWindow : public RenderBackend {
+public:
+    OffscreenWindow(unsigned width, unsigned height) {
+        ok = texture.create(width, height);
+        if (!ok) std::fprintf(stderr, "Warning: could not create a %ux%u offscreen render texture\n", width, height);
     }
 
-    bool pollEvent(sf::Event& event) {
-        return window.pollEvent(event);
+    // Write every n-th displayed frame to dir (n = 0 turns dumping off)
+    void dumpFrames(const std::string& dir, unsigned every = 1) {
+        dumpDir = dir;
+        dumpEvery = every;
     }
 
-    sf::Vector2u getSize() {
-        return window.getSize();
+    void pushEvent(const sf::Event& event) { events.push_back(event); }
+
+    // Save the last displayed frame; the readback also waits for the GPU
+    bool saveFrame(const std::string& path) const { return texture.getTexture().copyToImage().saveToFile(path); }
+
+    unsigned frameCount() const { return frames; }
+    bool created() const { return ok; }
+
+    sf::RenderTarget& target() override { return texture; }
+    bool isOpen() const override { return open; }
+    void close() override { open = false; }
+    bool pollEvent(sf::Event& event) override {
+        if (events.empty()) return false;
+        event = events.front();
+        events.pop_front();
+        return true;
+    }
+    void display() override {
+        texture.display();
+        ++frames;
+        if (!dumpDir.empty() && dumpEvery > 0 && frames % dumpEvery == 0) {
+            char name[32];
+            std::snprintf(name, sizeof(name), "/frame_%05u.png", frames);
+            if (!saveFrame(dumpDir + name)) std::fprintf(stderr, "Warning: could not write '%s%s'\n", dumpDir.c_str(), name);
+        }
     }
+    sf::Vector2u getSize() const override { return texture.getSize(); }
+    bool isInteractive() const override { return false; }
+    void finish() override { texture.getTexture().copyToImage(); }
+    bool setActive(bool active) override { return texture.setActive(active); }
 
 private:
-    sf::RenderWindow window;
-};
\ No newline at end of file
+    sf::RenderTexture texture;
+    std::deque<sf::Event> events;
+    std::string dumpDir;
+    unsigned dumpEvery = 0;
+    unsigned frames = 0;
+    bool ok = false;
+    bool open = true;
+};
+
+#endif // GAME_WINDOW_HPP
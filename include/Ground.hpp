@@ -1,8 +1,11 @@
+#ifndef GROUND_HPP
+#define GROUND_HPP
+
 #include <chipmunk/chipmunk.h>
 
 class Suelo {
 public:
-    Suelo(cpSpace* space) {
+    Suelo(cpSpace* space) : space(space) {
         cpBody* ground = cpSpaceGetStaticBody(space);
         shape = cpSegmentShapeNew(ground, cpv(0, 500), cpv(800, 500), 0);
         cpShapeSetFriction(shape, 1.0);
@@ -10,9 +13,16 @@ public:
     }
 
     ~Suelo() {
+        cpSpaceRemoveShape(space, shape);
         cpShapeFree(shape);
     }
 
+    Suelo(const Suelo&) = delete;
+    Suelo& operator=(const Suelo&) = delete;
+
 private:
+    cpSpace* space;
     cpShape* shape;
-};
\ No newline at end of file
+};
+
+#endif // GROUND_HPP
@@ -0,0 +1,48 @@
+#ifndef HIT_MASK_H
+#define HIT_MASK_H
+
+#include <SFML/Graphics/Image.hpp>
+#include <cstdint>
+#include <vector>
+
+// One bit per texel: set where the image is opaque enough to be hit.
+// Built once from the image a texture is created from, so hit tests never
+// read pixels back at runtime.
+class HitMask {
+public:
+    HitMask() = default;
+
+    // Texels with alpha >= threshold count as solid
+    explicit HitMask(const sf::Image& image, sf::Uint8 threshold = 64) { build(image, threshold); }
+
+    void build(const sf::Image& image, sf::Uint8 threshold = 64) {
+        width_ = image.getSize().x;
+        height_ = image.getSize().y;
+        stride_ = (width_ + 63) / 64;
+        bits_.assign(static_cast<std::size_t>(stride_) * height_, 0);
+        const sf::Uint8* px = image.getPixelsPtr();
+        if (!px) return;
+        for (unsigned y = 0; y < height_; ++y) {
+            std::uint64_t* row = &bits_[static_cast<std::size_t>(y) * stride_];
+            for (unsigned x = 0; x < width_; ++x, px += 4)
+                if (px[3] >= threshold) row[x >> 6] |= std::uint64_t(1) << (x & 63);
+        }
+    }
+
+    // Texel coordinates; anything outside the image is empty
+    bool test(int x, int y) const {
+        if (x < 0 || y < 0 || static_cast<unsigned>(x) >= width_ || static_cast<unsigned>(y) >= height_) return false;
+        return (bits_[static_cast<std::size_t>(y) * stride_ + (static_cast<unsigned>(x) >> 6)] >> (x & 63)) & 1u;
+    }
+
+    bool empty() const { return bits_.empty(); }
+    std::size_t bytes() const { return bits_.capacity() * sizeof(std::uint64_t); }
+
+private:
+    unsigned width_ = 0;
+    unsigned height_ = 0;
+    unsigned stride_ = 0; // 64-bit words per row
+    std::vector<std::uint64_t> bits_;
+};
+
+#endif // HIT_MASK_H
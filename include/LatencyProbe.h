@@ -0,0 +1,68 @@
+#ifndef LATENCY_PROBE_H
+#define LATENCY_PROBE_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Click-to-photon latency. Every click is tagged with the time it arrived;
+// the shot it fires records when the hit or miss was resolved and which
+// snapshot tick first shows the result. Whichever thread draws that
+// snapshot (or a later one, if it was skipped) stamps the time display()
+// returned. The report has both stages, in ms from arrival.
+//
+// SFML events carry no timestamp, so a real click arrives when it is
+// polled and time spent in the OS queue before that is not seen. Synthetic
+// clicks arrive at a scheduled instant, so the wait for the next poll is
+// part of their latency, as it is for a real mouse.
+class LatencyProbe {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    // Simulation thread: the click that arrived at `arrived` was resolved
+    // now, and the snapshot of `tick` is the first to show it
+    void resolved(Clock::time_point arrived, std::uint64_t tick, bool hit);
+    // Drawing thread, right after display(): every click resolved up to tick is on screen
+    void presented(std::uint64_t tick);
+
+    // Clicks measured all the way to the screen
+    std::size_t count() const;
+
+    void print(std::ostream& out, const std::string& label) const;
+    bool writeJson(const std::string& path, const std::string& label) const;
+
+private:
+    static const int BUCKET_MS = 2;
+    static const int BUCKETS = 50; // the last one also takes everything slower
+
+    struct Pending {
+        Clock::time_point arrived;
+        Clock::time_point resolved;
+        std::uint64_t tick;
+        bool hit;
+    };
+    struct Sample {
+        float resolveMs;
+        float displayMs;
+        bool hit;
+    };
+
+    struct Summary {
+        std::size_t hits = 0;
+        float resolve[4] = {}; // p50, p90, p99, max
+        float display[4] = {};
+        std::vector<std::size_t> histogram; // of display latency, BUCKET_MS wide
+    };
+    Summary summarize() const;
+
+    // The two threads meet here at most once per frame each
+    mutable std::mutex mutex_;
+    std::vector<Pending> pending_;
+    std::vector<Sample> samples_;
+};
+
+#endif // LATENCY_PROBE_H
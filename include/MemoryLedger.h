@@ -0,0 +1,72 @@
+#ifndef MEMORY_LEDGER_H
+#define MEMORY_LEDGER_H
+
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+namespace sf {
+class Image;
+class Texture;
+}
+
+// Where the memory goes, per subsystem: bytes held on the CPU and on the
+// GPU by textures, images, glyph pages, audio buffers and entity pools.
+// Owners keep an Account next to what they hold and set() it when that
+// changes size; the account leaves the ledger with its owner. GPU bytes are
+// estimates from sizes and formats (RGBA8, no mipmaps), not driver figures.
+//
+// Accounts may be set from any thread (audio loads on a worker). Setting
+// one takes a lock, so do it when memory changes, not every frame.
+class MemoryLedger {
+public:
+    enum System { Ducks, Scenery, Text, Audio, Particles, Render, Logging, SystemCount };
+
+    struct Bytes {
+        std::size_t cpu = 0;
+        std::size_t gpu = 0;
+    };
+
+    class Account {
+    public:
+        Account(System system, const std::string& name);
+        ~Account();
+        Account(const Account&) = delete;
+        Account& operator=(const Account&) = delete;
+
+        void set(std::size_t cpuBytes, std::size_t gpuBytes);
+
+    private:
+        friend class MemoryLedger;
+        System system_;
+        std::string name_;
+        Bytes bytes_;
+    };
+
+    static const char* systemName(System system);
+    static Bytes total(System system);
+    static Bytes total();
+
+    // Every account, grouped by subsystem, with totals and the budget
+    static void print(std::ostream& out);
+    // One line per subsystem, for the debug overlay
+    static std::string summary();
+
+    // Per-instance budget for CPU + GPU bytes (0 = none). Crossing it prints
+    // a warning once.
+    static void setBudget(std::size_t bytes);
+    static std::size_t budget();
+
+    // Size estimates for SFML resources
+    static std::size_t textureBytes(const sf::Texture& texture);
+    static std::size_t imageBytes(const sf::Image& image);
+    static std::size_t pixelBytes(const sf::Vector2u& size) { return static_cast<std::size_t>(size.x) * size.y * 4; }
+
+    // Dump on SIGUSR1 (POSIX only): the handler only raises a flag, which
+    // the game loop takes and prints
+    static void dumpOnSignal();
+    static bool takeDumpRequest();
+};
+
+#endif // MEMORY_LEDGER_H
@@ -0,0 +1,41 @@
+#ifndef MOTION_CONTROLLER_HPP
+#define MOTION_CONTROLLER_HPP
+
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Window/Keyboard.hpp>
+
+// Turns held direction keys into a displacement for the current frame.
+// Speed is in pixels per second and is multiplied by the frame's dt, so the
+// character covers the same distance per second at any frame rate.
+class MotionController {
+public:
+    struct Keys {
+        sf::Keyboard::Key left, right, up, down;
+    };
+
+    static Keys arrows() { return {sf::Keyboard::Left, sf::Keyboard::Right, sf::Keyboard::Up, sf::Keyboard::Down}; }
+    static Keys wasd() { return {sf::Keyboard::A, sf::Keyboard::D, sf::Keyboard::W, sf::Keyboard::S}; }
+
+    explicit MotionController(float speed, const Keys& keys = arrows()) : speed(speed), keys(keys) {}
+
+    void setSpeed(float pixelsPerSecond) { speed = pixelsPerSecond; }
+    float getSpeed() const { return speed; }
+
+    // Displacement in pixels for a frame that lasted dt seconds.
+    // Diagonals are normalised so they are not faster than straight moves.
+    sf::Vector2f step(float dt) const {
+        sf::Vector2f dir(0.f, 0.f);
+        if (sf::Keyboard::isKeyPressed(keys.left))  dir.x -= 1.f;
+        if (sf::Keyboard::isKeyPressed(keys.right)) dir.x += 1.f;
+        if (sf::Keyboard::isKeyPressed(keys.up))    dir.y -= 1.f;
+        if (sf::Keyboard::isKeyPressed(keys.down))  dir.y += 1.f;
+        if (dir.x != 0.f && dir.y != 0.f) dir *= 0.70710678f;
+        return dir * (speed * dt);
+    }
+
+private:
+    float speed;
+    Keys keys;
+};
+
+#endif // MOTION_CONTROLLER_HPP
@@ -0,0 +1,73 @@
+#ifndef PARTICLE_SYSTEM_H
+#define PARTICLE_SYSTEM_H
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "MemoryLedger.h"
+
+// Short-lived hit feedback: feathers, muzzle flash, dust.
+//
+// Particles live in a fixed-capacity structure of arrays, so the update loop
+// streams through a few float arrays and nothing is allocated after
+// construction. Dead particles are swapped with the last live one. When the
+// pool is full new particles are dropped (and counted). update() also writes
+// the quads of all live particles into one vertex array, drawn in a single
+// call.
+class ParticleSystem : public sf::Drawable {
+public:
+    explicit ParticleSystem(std::size_t capacity = 100000);
+
+    // Burst of count particles at pos. Angles in degrees (0 = right, 90 = down).
+    struct Burst {
+        std::size_t count = 16;
+        float angle = 0.f, spread = 360.f;
+        float speedMin = 50.f, speedMax = 150.f;
+        float lifeMin = 0.4f, lifeMax = 0.8f;
+        float sizeMin = 2.f, sizeMax = 4.f;
+        float gravity = 0.f; // px/s^2
+        float drag = 0.f;    // fraction of velocity lost per second
+        sf::Color color = sf::Color::White;
+    };
+    void emit(const sf::Vector2f& pos, const Burst& burst);
+
+    // Presets used by the game
+    void emitFeathers(const sf::Vector2f& pos);
+    void emitMuzzleFlash(const sf::Vector2f& pos);
+    void emitImpact(const sf::Vector2f& pos);
+
+    // Integrate, drop dead particles and rebuild the vertices
+    void update(float dt);
+    void clear() { count_ = 0; }
+
+    std::size_t size() const { return count_; }
+    std::size_t capacity() const { return capacity_; }
+    std::size_t dropped() const { return dropped_; }
+
+    // Triangles written by the last update(), two per particle
+    const sf::Vertex* vertices() const { return vertices_.data(); }
+    std::size_t vertexCount() const { return count_ * 6; }
+
+private:
+    float random01();
+    float randomRange(float a, float b) { return a + (b - a) * random01(); }
+    void kill(std::size_t i);
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+    std::size_t capacity_;
+    std::size_t count_ = 0;
+    std::size_t dropped_ = 0;
+    std::uint32_t rng_ = 0x9E3779B9u;
+
+    // one entry per particle
+    std::vector<float> x_, y_, vx_, vy_;
+    std::vector<float> life_, invMaxLife_, size_, gravity_, drag_;
+    std::vector<sf::Color> color_;
+
+    std::vector<sf::Vertex> vertices_; // 6 per particle (two triangles)
+    MemoryLedger::Account memory_{MemoryLedger::Particles, "particle pool"};
+};
+
+#endif // PARTICLE_SYSTEM_H
@@ -1,16 +1,57 @@
+#ifndef PHYSICS_SPACE_HPP
+#define PHYSICS_SPACE_HPP
+
+#include <chipmunk/chipmunk.h>
 
 class PhysicsSpace {
 public:
-    PhysicsSpace() {
-        space = cpSpaceNew();
+    // Solver and broad-phase settings. Defaults match a plain cpSpaceNew()
+    // except for the gravity the examples use.
+    struct Config {
         cpVect gravity = cpv(0, 1000);
-        cpSpaceSetGravity(space, gravity);
+        int iterations = 10;               // solver iterations per step
+
+        // Broad-phase: Chipmunk's default is an AABB tree. A spatial hash is
+        // faster with many objects of similar size; cell size should be
+        // close to the typical object diameter and the count around 10x the
+        // number of shapes. Only applied at construction.
+        bool useSpatialHash = false;
+        cpFloat hashCellSize = 20.0;
+        int hashCount = 1000;
+
+        cpFloat sleepTimeThreshold = INFINITY; // seconds idle before a body sleeps (INFINITY = never)
+        cpFloat idleSpeedThreshold = 0.0;      // 0 = estimate from gravity
+        cpFloat collisionSlop = 0.1;           // allowed overlap, in pixels
+        cpFloat damping = 1.0;                 // fraction of velocity kept per second
+    };
+
+    PhysicsSpace() : PhysicsSpace(Config()) {}
+
+    explicit PhysicsSpace(const Config& config) {
+        space = cpSpaceNew();
+        if (config.useSpatialHash) cpSpaceUseSpatialHash(space, config.hashCellSize, config.hashCount);
+        configure(config);
     }
 
+    // Bodies and shapes must be removed (Ball, Suelo, BallPool destructors)
+    // before the space is freed
     ~PhysicsSpace() {
         cpSpaceFree(space);
     }
 
+    PhysicsSpace(const PhysicsSpace&) = delete;
+    PhysicsSpace& operator=(const PhysicsSpace&) = delete;
+
+    // Re-apply the solver settings (the broad-phase is fixed at construction)
+    void configure(const Config& config) {
+        cpSpaceSetGravity(space, config.gravity);
+        cpSpaceSetIterations(space, config.iterations);
+        cpSpaceSetSleepTimeThreshold(space, config.sleepTimeThreshold);
+        cpSpaceSetIdleSpeedThreshold(space, config.idleSpeedThreshold);
+        cpSpaceSetCollisionSlop(space, config.collisionSlop);
+        cpSpaceSetDamping(space, config.damping);
+    }
+
     cpSpace* getSpace() {
         return space;
     }
@@ -18,3 +59,5 @@ public:
 private:
     cpSpace* space;
 };
+
+#endif // PHYSICS_SPACE_HPP
@@ -0,0 +1,23 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <random>
+
+// One random source for the whole game (spawns, duck flight, sounds).
+// It is seeded from std::random_device unless seedRandom() is called
+// first; headless runs pass a fixed seed so their frames are reproducible.
+inline std::mt19937& randomEngine() {
+    static std::mt19937 gen(std::random_device{}());
+    return gen;
+}
+
+inline void seedRandom(unsigned seed) {
+    randomEngine().seed(seed);
+}
+
+inline float randRange(float a, float b) {
+    std::uniform_real_distribution<float> dist(a, b);
+    return dist(randomEngine());
+}
+
+#endif // RANDOM_H
@@ -0,0 +1,60 @@
+#ifndef RATE_LIMITED_LOG_HPP
+#define RATE_LIMITED_LOG_HPP
+
+#include <ostream>
+#include <sstream>
+#include <string>
+
+// Debug log for per-frame values. Lets through at most one line per interval
+// and collects lines in memory, writing them out in blocks (when flushBytes
+// have piled up or flushSeconds have passed, whichever comes first), so
+// logging from the game loop never flushes the stream every frame but the
+// output still shows up while the game runs.
+//
+//     if (log.ready(dt)) log.line() << "x: " << x << '\n';
+class RateLimitedLog {
+public:
+    RateLimitedLog(std::ostream& out, float intervalSeconds, std::size_t flushBytes = 4096, float flushSeconds = 1.f)
+        : out_(out), interval_(intervalSeconds), flushBytes_(flushBytes), flushSeconds_(flushSeconds) {}
+
+    ~RateLimitedLog() { flush(); }
+
+    RateLimitedLog(const RateLimitedLog&) = delete;
+    RateLimitedLog& operator=(const RateLimitedLog&) = delete;
+
+    // Advance the timer; true when a new line may be written
+    bool ready(float dt) {
+        sinceFlush_ += dt;
+        if (sinceFlush_ >= flushSeconds_ || buffer_.tellp() >= static_cast<std::streamoff>(flushBytes_)) flush();
+        elapsed_ += dt;
+        if (elapsed_ < interval_) return false;
+        // keep the remainder so the interval does not drift, but let a long
+        // frame through as one line, not a burst
+        elapsed_ -= interval_;
+        if (elapsed_ >= interval_) elapsed_ = 0.f;
+        return true;
+    }
+
+    // Stream for the current line (end it with '\n', not std::endl)
+    std::ostream& line() { return buffer_; }
+
+    void flush() {
+        sinceFlush_ = 0.f;
+        std::string text = buffer_.str();
+        if (text.empty()) return;
+        out_.write(text.data(), static_cast<std::streamsize>(text.size()));
+        out_.flush();
+        buffer_.str(std::string());
+    }
+
+private:
+    std::ostream& out_;
+    float interval_;
+    std::size_t flushBytes_;
+    float flushSeconds_;
+    float elapsed_ = 0.f;
+    float sinceFlush_ = 0.f;
+    std::ostringstream buffer_;
+};
+
+#endif // RATE_LIMITED_LOG_HPP
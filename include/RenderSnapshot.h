@@ -0,0 +1,44 @@
+#ifndef RENDER_SNAPSHOT_H
+#define RENDER_SNAPSHOT_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Everything needed to draw one frame, copied out of the simulation at the
+// end of a tick. The renderer only reads this and resources that do not
+// change after Game::init() (atlas, grass, pond), so a frame can be drawn
+// on another thread while the next tick runs. Vectors are cleared, not
+// freed, between frames: refilling a snapshot does not allocate once the
+// capacities have settled.
+struct RenderSnapshot {
+    // One duck: textured sprite, or the placeholder rectangle when texture is null
+    struct Sprite {
+        std::shared_ptr<const sf::Texture> texture; // keeps shared duck art alive while drawn
+        sf::IntRect rect;
+        sf::Transform transform;
+        sf::Vector2f size; // placeholder only
+        sf::Color color;   // placeholder only
+    };
+
+    sf::Vector2u windowSize;   // letterbox for this size
+    sf::Color clear = sf::Color::Black;
+    bool pond = false;         // instructions background
+    bool world = false;        // sky, grass, ducks and particles, at the dynamic resolution
+    std::vector<Sprite> ducks;
+    std::vector<sf::Vertex> particles; // triangles
+    std::vector<sf::Vertex> text;      // triangles in the text atlas, drawn over everything
+    std::uint64_t tick = 0;
+
+    void reset() {
+        clear = sf::Color::Black;
+        pond = false;
+        world = false;
+        ducks.clear();
+        particles.clear();
+        text.clear();
+    }
+};
+
+#endif // RENDER_SNAPSHOT_H
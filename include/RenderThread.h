@@ -0,0 +1,66 @@
+#ifndef RENDER_THREAD_H
+#define RENDER_THREAD_H
+
+#include "GameWindow.hpp"
+#include "RenderSnapshot.h"
+#include "TripleBuffer.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// Draws snapshots on a thread of its own, so a slow submit or present no
+// longer holds up the next simulation tick.
+//
+// The simulation thread keeps the window (its events have to be polled on
+// the thread that created it) and hands the OpenGL context over to the
+// render thread for as long as it runs. Each tick fills back() and
+// publish()es it through a triple buffer; the render thread always draws
+// the newest snapshot and skips any it did not get to in time. Publishing
+// never waits for drawing.
+class RenderThread {
+public:
+    typedef std::function<void(const RenderSnapshot&)> DrawFn;
+
+    ~RenderThread() { stop(); }
+
+    // The calling thread gives up the backend's context until stop().
+    // Waits until the render thread has taken the context over; if it could
+    // not, the thread is joined, the context comes back and false is returned
+    // (running() stays false, so drawing stays on the calling thread).
+    bool start(RenderBackend& backend, DrawFn draw);
+    // Finish the frame being drawn, join, and make the context current here again
+    void stop();
+    bool running() const { return thread_.joinable(); }
+
+    RenderSnapshot& back() { return frames_.back(); }
+    void publish();
+
+    unsigned long long published() const { return published_.load(std::memory_order_relaxed); }
+    unsigned long long drawn() const { return drawn_.load(std::memory_order_relaxed); }
+
+private:
+    void loop();
+
+    RenderBackend* backend_ = nullptr;
+    DrawFn draw_;
+    TripleBuffer<RenderSnapshot> frames_;
+    std::thread thread_;
+
+    // only wakes the render thread up; snapshots go through frames_
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool pending_ = false;
+    bool stop_ = false;
+    // start() waits on this for the render thread to report on the context
+    enum class Context { Waiting, Active, Failed };
+    std::condition_variable started_;
+    Context context_ = Context::Waiting;
+
+    std::atomic<unsigned long long> published_{0};
+    std::atomic<unsigned long long> drawn_{0};
+};
+
+#endif // RENDER_THREAD_H
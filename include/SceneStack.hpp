@@ -0,0 +1,79 @@
+#ifndef SCENE_STACK_HPP
+#define SCENE_STACK_HPP
+
+#include <SFML/Window/Event.hpp>
+
+#include "RenderSnapshot.h"
+
+#include <vector>
+
+// One screen of the game (instructions, the round, game over). The main
+// loop hands events, updates and renders to the scenes on a SceneStack;
+// scenes never run their own loop or sleep, so the window keeps pumping
+// events whatever is on screen. Rendering means describing the frame in a
+// RenderSnapshot, which is drawn on this thread or a render thread.
+class Scene {
+public:
+    virtual ~Scene() = default;
+
+    virtual void enter() {} // became the top scene
+    virtual void exit() {}  // stopped being the top scene (popped, replaced or covered)
+    virtual void handleEvent(const sf::Event&) {}
+    virtual void update(float dt) = 0;
+    virtual void render(RenderSnapshot& frame) = 0;
+
+    // False for overlays (e.g. a pause menu): the scenes below are drawn first
+    virtual bool opaque() const { return true; }
+};
+
+// Stack of scenes owned elsewhere. Only the top scene gets events and
+// updates; rendering starts at the highest opaque scene. push, pop and
+// replace are queued and applied by applyPending() at the start of a frame,
+// so a scene can ask for a transition from its own update or handleEvent.
+class SceneStack {
+public:
+    SceneStack() {
+        stack_.reserve(4);
+        pending_.reserve(4);
+    }
+
+    void push(Scene* scene) { pending_.push_back(Request{Op::Push, scene}); }
+    void pop() { pending_.push_back(Request{Op::Pop, nullptr}); }
+    void replace(Scene* scene) { pending_.push_back(Request{Op::Replace, scene}); }
+
+    void applyPending() {
+        for (const Request& r : pending_) {
+            if (Scene* top = this->top()) top->exit();
+            if (r.op != Op::Push && !stack_.empty()) stack_.pop_back();
+            if (r.op != Op::Pop) stack_.push_back(r.scene);
+            if (Scene* top = this->top()) top->enter();
+        }
+        pending_.clear();
+    }
+
+    Scene* top() const { return stack_.empty() ? nullptr : stack_.back(); }
+    bool empty() const { return stack_.empty(); }
+
+    void handleEvent(const sf::Event& event) {
+        if (Scene* top = this->top()) top->handleEvent(event);
+    }
+    void update(float dt) {
+        if (Scene* top = this->top()) top->update(dt);
+    }
+    void render(RenderSnapshot& frame) {
+        std::size_t first = stack_.size();
+        while (first > 0 && !stack_[--first]->opaque()) {}
+        for (std::size_t i = first; i < stack_.size(); ++i) stack_[i]->render(frame);
+    }
+
+private:
+    enum class Op { Push, Pop, Replace };
+    struct Request {
+        Op op;
+        Scene* scene;
+    };
+    std::vector<Scene*> stack_;
+    std::vector<Request> pending_;
+};
+
+#endif // SCENE_STACK_HPP
@@ -0,0 +1,126 @@
+#ifndef SHAPE_CACHE_HPP
+#define SHAPE_CACHE_HPP
+
+#include <SFML/Graphics.hpp>
+
+#include <cstddef>
+#include <vector>
+
+// Retained-mode layer for static primitives. Shapes are added once and
+// tessellated into one shared triangle list; setters only mark the node
+// dirty, and update() rewrites the vertices of dirty nodes. Drawing the
+// scene is a single draw call from a GPU vertex buffer (or from the CPU
+// vertex array when vertex buffers are not supported).
+//
+// Only the fill of convex shapes (sf::CircleShape, sf::RectangleShape,
+// sf::ConvexShape) is cached; outlines and textures are ignored.
+class ShapeCache : public sf::Drawable {
+public:
+    typedef std::size_t NodeId;
+
+    ShapeCache() : vertices(sf::Triangles), buffer(sf::Triangles, sf::VertexBuffer::Static) {}
+
+    // Copy the shape's points, transform and fill colour into the cache
+    NodeId add(const sf::Shape& shape) {
+        Node node;
+        std::size_t count = shape.getPointCount();
+        node.points.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) node.points.push_back(shape.getPoint(i));
+        node.transform.setOrigin(shape.getOrigin());
+        node.transform.setPosition(shape.getPosition());
+        node.transform.setRotation(shape.getRotation());
+        node.transform.setScale(shape.getScale());
+        node.color = shape.getFillColor();
+        node.first = vertices.getVertexCount();
+        node.count = count >= 3 ? (count - 2) * 3 : 0; // triangle fan as a list
+        vertices.resize(node.first + node.count);
+        nodes.push_back(node);
+        markDirty(nodes.size() - 1);
+        layoutChanged = true;
+        return nodes.size() - 1;
+    }
+
+    void setPosition(NodeId id, const sf::Vector2f& position) { nodes[id].transform.setPosition(position); markDirty(id); }
+    void setRotation(NodeId id, float angle) { nodes[id].transform.setRotation(angle); markDirty(id); }
+    void setScale(NodeId id, const sf::Vector2f& scale) { nodes[id].transform.setScale(scale); markDirty(id); }
+    void setFillColor(NodeId id, const sf::Color& color) { nodes[id].color = color; markDirty(id); }
+
+    // Hidden nodes keep their slot and are collapsed to zero-area triangles
+    void setVisible(NodeId id, bool visible) { nodes[id].visible = visible; markDirty(id); }
+
+    const sf::Vector2f& getPosition(NodeId id) const { return nodes[id].transform.getPosition(); }
+    std::size_t size() const { return nodes.size(); }
+    std::size_t vertexCount() const { return vertices.getVertexCount(); }
+
+    // Rebuild the vertices of dirty nodes and upload them. Call once per
+    // frame before drawing; it does nothing when no node changed.
+    void update() {
+        if (dirty.empty()) return;
+        for (NodeId id : dirty) {
+            rebuild(nodes[id]);
+            nodes[id].dirty = false;
+        }
+
+        if (sf::VertexBuffer::isAvailable()) {
+            if (layoutChanged || buffer.getVertexCount() != vertices.getVertexCount()) {
+                buffer.create(vertices.getVertexCount());
+                buffer.update(&vertices[0]);
+            } else {
+                for (NodeId id : dirty) {
+                    const Node& n = nodes[id];
+                    if (n.count) buffer.update(&vertices[n.first], n.count, static_cast<unsigned>(n.first));
+                }
+            }
+        }
+        layoutChanged = false;
+        dirty.clear();
+    }
+
+private:
+    struct Node {
+        std::vector<sf::Vector2f> points;
+        sf::Transformable transform;
+        sf::Color color;
+        std::size_t first = 0;
+        std::size_t count = 0;
+        bool visible = true;
+        bool dirty = false;
+    };
+
+    void markDirty(NodeId id) {
+        if (nodes[id].dirty) return;
+        nodes[id].dirty = true;
+        dirty.push_back(id);
+    }
+
+    void rebuild(const Node& n) {
+        const sf::Transform& t = n.transform.getTransform();
+        const sf::Vector2f p0 = t.transformPoint(n.points.empty() ? sf::Vector2f() : n.points[0]);
+        for (std::size_t i = 0; i + 2 < n.points.size(); ++i) {
+            sf::Vertex* v = &vertices[n.first + i * 3];
+            if (!n.visible) {
+                v[0] = v[1] = v[2] = sf::Vertex(p0, sf::Color::Transparent);
+                continue;
+            }
+            v[0] = sf::Vertex(p0, n.color);
+            v[1] = sf::Vertex(t.transformPoint(n.points[i + 1]), n.color);
+            v[2] = sf::Vertex(t.transformPoint(n.points[i + 2]), n.color);
+        }
+    }
+
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override {
+        if (vertices.getVertexCount() == 0) return;
+        if (sf::VertexBuffer::isAvailable() && buffer.getVertexCount() == vertices.getVertexCount())
+            target.draw(buffer, states);
+        else
+            target.draw(vertices, states);
+    }
+
+    std::vector<Node> nodes;
+    std::vector<NodeId> dirty;
+    sf::VertexArray vertices;
+    sf::VertexBuffer buffer;
+    bool layoutChanged = false;
+};
+
+#endif // SHAPE_CACHE_HPP
@@ -0,0 +1,48 @@
+#ifndef STRESS_TEST_H
+#define STRESS_TEST_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Load generator for Game::runStress: the spawn rate grows geometrically,
+// level by level. Every level is held for a fixed stretch of game time
+// while frame times are recorded. Nothing shoots the ducks, so their
+// number keeps climbing. The run stops at the first level whose p99 frame
+// time misses the budget; the duck count at the end of the level before it
+// is the maximum the machine sustains.
+struct StressSettings {
+    float startRate = 2.f;         // ducks spawned per second in level 1
+    float rateGrowth = 1.5f;       // each level multiplies the rate by this
+    float holdSeconds = 5.f;       // game time per level
+    int maxLevels = 30;
+    float budgetMs = 1000.f / 60.f;
+};
+
+struct StressLevel {
+    int level = 0;
+    float spawnRate = 0.f;
+    std::size_t ducksStart = 0;
+    std::size_t ducksEnd = 0;
+    int frames = 0;
+    float p50Ms = 0.f, p99Ms = 0.f, worstMs = 0.f;  // whole frame
+    float inputMs = 0.f, updateMs = 0.f, renderMs = 0.f; // per-phase means
+    bool withinBudget = false;
+};
+
+struct StressReport {
+    std::string backend; // "window" or "offscreen"
+    float budgetMs = 0.f;
+    float renderScale = 1.f;
+    std::vector<StressLevel> levels;
+    std::size_t maxDucks = 0; // ducks alive at the end of the last level within budget
+
+    // Nearest-rank percentile (0..1) of frame times; sorts times
+    static float percentile(std::vector<float>& times, float p);
+
+    void print(std::ostream& out) const;
+    bool writeJson(const std::string& path) const;
+};
+
+#endif // STRESS_TEST_H
@@ -0,0 +1,84 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "MemoryLedger.h"
+
+// Structured session telemetry: shots, hits, misses, spawns, lives lost and
+// per-frame timings, written as JSON lines (one object per record).
+//
+// The game thread only copies a small fixed-size record into a lock-free
+// single-producer / single-consumer ring; a background thread drains it
+// every few milliseconds, formats the records and writes them in batches.
+// Logging never blocks, locks or allocates: if the ring is ever full the
+// record is dropped and counted, and the count is written at session end.
+// Records must only be logged from one thread (the game loop).
+class Telemetry {
+public:
+    enum class Event : std::uint8_t {
+        RoundStart, // value = round number
+        Shot,       // x, y = world position
+        Hit,        // x, y = duck position, value = score after the hit
+        Miss,       // x, y = world position
+        LifeLost,   // value = lives left
+        GameOver,   // value = final score
+        Spawn,      // x, y = start position, count = ducks alive
+        Frame,      // value = frame ms, x = update ms, y = render ms, count = ducks alive
+    };
+
+    Telemetry() = default;
+    ~Telemetry() { close(); }
+
+    Telemetry(const Telemetry&) = delete;
+    Telemetry& operator=(const Telemetry&) = delete;
+
+    // Start a session writing to path and the writer thread. capacity is
+    // rounded up to a power of two.
+    bool open(const std::string& path, std::size_t capacity = 16384);
+    // Write what is left, the session_end line, and stop the writer
+    void close();
+    bool isOpen() const { return file_ != nullptr; }
+
+    void log(Event type, float x = 0.f, float y = 0.f, float value = 0.f, std::uint32_t count = 0);
+    // Frame record; also advances the frame number the other records carry
+    void frame(float ms, float updateMs, float renderMs, std::uint32_t ducks) {
+        log(Event::Frame, updateMs, renderMs, ms, ducks);
+        ++frame_;
+    }
+
+    unsigned long long dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    struct Record {
+        std::uint32_t frame;
+        float t; // seconds since the session started
+        Event type;
+        float x, y, value;
+        std::uint32_t count;
+    };
+
+    void writerLoop();
+    void drain(std::string& batch);
+    static void format(const Record& r, std::string& out);
+
+    std::FILE* file_ = nullptr;
+    std::thread writer_;
+    std::atomic<bool> stop_{false};
+    std::vector<Record> ring_;
+    std::size_t mask_ = 0;
+    std::atomic<std::size_t> head_{0}; // next slot the game writes
+    std::atomic<std::size_t> tail_{0}; // next slot the writer reads
+    std::atomic<unsigned long long> dropped_{0};
+    unsigned long long written_ = 0;
+    std::uint32_t frame_ = 0;
+    double startSeconds_ = 0.0; // steady clock at open()
+    MemoryLedger::Account memory_{MemoryLedger::Logging, "telemetry ring"};
+};
+
+#endif // TELEMETRY_H
@@ -0,0 +1,116 @@
+#ifndef TEXT_ATLAS_H
+#define TEXT_ATLAS_H
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "MemoryLedger.h"
+
+// All on-screen text of the game, drawn in one draw call.
+//
+// Fonts and the (size, bold, outline) styles the game uses are registered
+// up front; bake() rasterises the printable ASCII range plus the Spanish
+// accented letters for every style and packs them into a single texture.
+// Outlines are baked as a second glyph set (SFML's outline rasterisation),
+// so an outlined run is just the outline quads followed by the fill quads.
+//
+// Text runs are laid out into one shared vertex buffer that is rebuilt only
+// when a run changes. Hidden runs cost nothing, so each screen shows the
+// runs it needs and hides the others.
+class TextAtlas : public sf::Drawable {
+public:
+    typedef std::size_t FontId;
+    typedef std::size_t StyleId;
+    typedef std::size_t TextId;
+
+    enum class Align { TopLeft, Center };
+
+    TextAtlas();
+
+    // Returns false if the file cannot be opened; the id is still valid
+    // and its styles bake no glyphs.
+    bool addFont(const std::string& path, FontId& id);
+    StyleId addStyle(FontId font, unsigned size, bool bold = false, float outlineThickness = 0.f);
+
+    // Rasterise every style into the atlas. Call once after adding styles.
+    void bake();
+    bool isBaked() const { return baked_; }
+    const sf::Texture& getTexture() const { return texture_; }
+
+    // Text runs. Strings are UTF-8.
+    TextId add(StyleId style, const std::string& text, const sf::Vector2f& position,
+               const sf::Color& fill = sf::Color::White, const sf::Color& outline = sf::Color::Black,
+               Align align = Align::TopLeft);
+    void setString(TextId id, const std::string& text);
+    void setPosition(TextId id, const sf::Vector2f& position);
+    void setFillColor(TextId id, const sf::Color& color);
+    void setVisible(TextId id, bool visible);
+    void hideAll();
+
+    // Size of the laid-out text (before alignment and position)
+    sf::FloatRect getLocalBounds(TextId id) const;
+
+    std::size_t vertexCount() const { return vertices_.getVertexCount(); }
+
+    // Triangles of the visible runs, textured with getTexture(). Lays the
+    // runs out if they changed but touches no OpenGL state, so it can feed
+    // a render thread from the simulation thread.
+    void copyVertices(std::vector<sf::Vertex>& out) const;
+
+private:
+    struct BakedGlyph {
+        sf::FloatRect bounds; // relative to the pen position on the baseline
+        sf::FloatRect uv;     // texel rect in the atlas
+        float advance = 0.f;
+    };
+
+    struct Style {
+        FontId font = 0;
+        unsigned size = 0;
+        bool bold = false;
+        float outline = 0.f;
+        float lineSpacing = 0.f;
+        std::map<sf::Uint32, BakedGlyph> fill;
+        std::map<sf::Uint32, BakedGlyph> outlineGlyphs;
+    };
+
+    struct Run {
+        StyleId style = 0;
+        std::vector<sf::Uint32> codepoints;
+        sf::Vector2f position;
+        sf::Color fill;
+        sf::Color outline;
+        Align align = Align::TopLeft;
+        bool visible = true;
+        sf::FloatRect bounds;
+    };
+
+    const BakedGlyph* findGlyph(const std::map<sf::Uint32, BakedGlyph>& glyphs, sf::Uint32 cp) const;
+    void layout(Run& run);
+    template <class Fn> void forEachGlyph(const Run& run, bool outlinePass, Fn fn) const;
+    void emit(const Run& run, bool outlinePass) const;
+    void rebuild() const;
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+    std::vector<std::unique_ptr<sf::Font>> fonts_;
+    std::vector<Style> styles_;
+    std::vector<Run> runs_;
+    sf::Texture texture_;
+    bool baked_ = false;
+
+    // Rebuilt lazily in draw() / copyVertices(), uploaded lazily in draw()
+    mutable bool dirty_ = true;
+    mutable bool uploaded_ = false;
+    mutable sf::VertexArray vertices_;
+    mutable sf::VertexBuffer buffer_;
+
+    // Atlas texture and vertices; the fonts' own per-size pages stay resident after bake()
+    mutable MemoryLedger::Account memory_{MemoryLedger::Text, "glyph atlas"};
+    MemoryLedger::Account fontPages_{MemoryLedger::Text, "font glyph pages"};
+};
+
+#endif // TEXT_ATLAS_H
@@ -0,0 +1,36 @@
+#ifndef TRIPLE_BUFFER_HPP
+#define TRIPLE_BUFFER_HPP
+
+#include <atomic>
+
+// Lock-free hand-over of the latest value from one writer thread to one
+// reader thread. The writer fills back() and publish()es it; the reader
+// acquire()s the newest published value and reads front(). Neither side
+// ever waits for the other: with three slots there is always one free to
+// write into, and values the reader did not get to are simply overwritten.
+template <class T>
+class TripleBuffer {
+public:
+    // Writer side
+    T& back() { return slots_[back_]; }
+    void publish() { back_ = middle_.exchange(back_ | FRESH, std::memory_order_acq_rel) & INDEX; }
+
+    // Reader side: true (and front() updated) if something new was published
+    bool acquire() {
+        if (!(middle_.load(std::memory_order_acquire) & FRESH)) return false;
+        front_ = middle_.exchange(front_, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+    const T& front() const { return slots_[front_]; }
+
+private:
+    static const int INDEX = 3;
+    static const int FRESH = 4;
+
+    T slots_[3];
+    int back_ = 0;                  // writer's slot
+    int front_ = 1;                 // reader's slot
+    std::atomic<int> middle_{2};    // last published slot, FRESH until the reader takes it
+};
+
+#endif // TRIPLE_BUFFER_HPP
@@ -0,0 +1,226 @@
+#ifndef TRON_BOT_HPP
+#define TRON_BOT_HPP
+
+// Bot controller for the Tron example (08_Tron.cpp).
+// Has no SFML dependency so the same code runs in the windowed example and
+// in the headless bot-vs-bot harness (bench/tron_bench.cpp).
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+struct TronDir {
+    int x;
+    int y;
+};
+
+// Up, Down, Left, Right (same encoding as Player::dir in 08_Tron.cpp)
+static const TronDir kTronDirs[4] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+
+// Occupancy grid. The Tron arena wraps around its edges, so every
+// coordinate is taken modulo the grid size.
+class TronGrid {
+public:
+    TronGrid(int width = 0, int height = 0) { Resize(width, height); }
+
+    void Resize(int width, int height)
+    {
+        w = width;
+        h = height;
+        cells.assign(static_cast<size_t>(w) * h, 0);
+        // neighbour table so the search never has to do modulo arithmetic
+        next.resize(static_cast<size_t>(w) * h * 4);
+        for (int c = 0; c < w * h; ++c)
+            for (int d = 0; d < 4; ++d)
+                next[c * 4 + d] = Index(c % w + kTronDirs[d].x, c / w + kTronDirs[d].y);
+    }
+
+    void Clear() { std::fill(cells.begin(), cells.end(), 0); }
+
+    int Width() const { return w; }
+    int Height() const { return h; }
+    int Size() const { return w * h; }
+
+    int Index(int x, int y) const
+    {
+        x %= w; if (x < 0) x += w;
+        y %= h; if (y < 0) y += h;
+        return y * w + x;
+    }
+
+    // Neighbour of `cell` in direction kTronDirs[dir]
+    int Step(int cell, int dir) const { return next[cell * 4 + dir]; }
+
+    bool Occupied(int cell) const { return cells[cell] != 0; }
+    void Set(int cell, bool value) { cells[cell] = value ? 1 : 0; }
+
+private:
+    int w = 0;
+    int h = 0;
+    std::vector<uint8_t> cells;
+    std::vector<int> next;
+};
+
+// Picks a direction with a shallow alpha-beta minimax over the occupancy grid.
+// Leaves are scored with a simultaneous BFS from both heads (cells we reach
+// first minus cells the enemy reaches first). Search is iterative deepening
+// and stops at the per-tick time budget, keeping the last completed depth.
+class TronBot {
+public:
+    explicit TronBot(std::chrono::microseconds budget = std::chrono::microseconds(2000), int maxDepth = 4)
+        : budget(budget), maxDepth(maxDepth) {}
+
+    // Scratch grid owned by the bot, filled by the caller before Decide()
+    TronGrid &Grid() { return grid; }
+
+    // Returns an index into kTronDirs. Never reverses onto its own trail.
+    int Decide(int me, int myDir, int enemy)
+    {
+        PrepareScratch();
+        deadline = Clock::now() + budget;
+        timedOut = false;
+        lastDepth = 0;
+
+        int best = SafeFallback(me, myDir);
+        for (int depth = 1; depth <= maxDepth; ++depth) {
+            int move = best;
+            int score = Search(me, enemy, depth, -kInf, kInf, &move);
+            if (timedOut) break; // keep the last completed depth (or the safe fallback)
+            best = move;
+            lastDepth = depth;
+            if (score >= kWin || score <= kLoss) break;
+        }
+        return best;
+    }
+
+    // Depth reached by the last Decide() call
+    int LastDepth() const { return lastDepth; }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    static const int kInf = std::numeric_limits<int>::max();
+    static const int kWin = 1000000;
+    static const int kLoss = -1000000;
+
+    int SafeFallback(int me, int myDir) const
+    {
+        for (int i = 0; i < 4; ++i)
+            if (!grid.Occupied(grid.Step(me, i))) return i;
+        return myDir;
+    }
+
+    void PrepareScratch()
+    {
+        if (static_cast<int>(dist.size()) != grid.Size()) {
+            dist.assign(grid.Size(), 0);
+            owner.assign(grid.Size(), 0);
+            stamp.assign(grid.Size(), 0);
+            queue.assign(grid.Size(), 0);
+            generation = 0;
+        }
+    }
+
+    bool OutOfTime()
+    {
+        if (!timedOut && Clock::now() >= deadline) timedOut = true;
+        return timedOut;
+    }
+
+    // Max node: we move, then the enemy answers (Min)
+    int Search(int me, int enemy, int depth, int alpha, int beta, int *bestMove)
+    {
+        // abandon the current iteration once the budget is gone; the
+        // partial result is discarded by Decide()
+        if (OutOfTime()) return 0;
+
+        int bestScore = -kInf;
+        for (int i = 0; i < 4; ++i) {
+            int nm = grid.Step(me, i);
+            int score;
+            if (grid.Occupied(nm)) {
+                score = kLoss - depth; // crashing later is better than now
+            } else {
+                grid.Set(nm, true);
+                score = kInf;
+                for (int j = 0; j < 4 && score > alpha; ++j) {
+                    int ne = grid.Step(enemy, j);
+                    int s;
+                    if (ne == nm) s = 0; // head-on collision: draw
+                    else if (grid.Occupied(ne)) s = kWin + depth;
+                    else if (OutOfTime()) s = 0; // same bail-out as above, also for leaves
+                    else {
+                        grid.Set(ne, true);
+                        s = depth <= 1 ? Evaluate(nm, ne) : Search(nm, ne, depth - 1, alpha, score, nullptr);
+                        grid.Set(ne, false);
+                    }
+                    if (s < score) score = s;
+                }
+                grid.Set(nm, false);
+            }
+            if (score > bestScore) {
+                bestScore = score;
+                if (bestMove) *bestMove = i;
+            }
+            if (bestScore > alpha) alpha = bestScore;
+            if (alpha >= beta) break;
+        }
+        return bestScore;
+    }
+
+    // Voronoi-style space evaluation: multi-source BFS from both heads
+    int Evaluate(int me, int enemy)
+    {
+        if (++generation == 0) {
+            std::fill(stamp.begin(), stamp.end(), 0);
+            generation = 1;
+        }
+        int head = 0, tail = 0;
+        auto visit = [&](int cell, int d, uint8_t who) {
+            stamp[cell] = generation;
+            dist[cell] = d;
+            owner[cell] = who;
+            queue[tail++] = cell;
+        };
+        visit(me, 0, 1);
+        visit(enemy, 0, 2);
+
+        int mine = 0, theirs = 0;
+        while (head < tail) {
+            int cell = queue[head++];
+            uint8_t who = owner[cell];
+            int d = dist[cell] + 1;
+            for (int i = 0; i < 4; ++i) {
+                int n = grid.Step(cell, i);
+                if (grid.Occupied(n)) continue;
+                if (stamp[n] != generation) {
+                    visit(n, d, who);
+                    if (who == 1) ++mine; else if (who == 2) ++theirs;
+                } else if (who != 0 && dist[n] == d && owner[n] != who && owner[n] != 0) {
+                    // reached by both at the same time: nobody owns it
+                    if (owner[n] == 1) --mine; else --theirs;
+                    owner[n] = 0;
+                }
+            }
+        }
+        return mine - theirs;
+    }
+
+    TronGrid grid;
+    std::chrono::microseconds budget;
+    int maxDepth;
+    int lastDepth = 0;
+    Clock::time_point deadline;
+    bool timedOut = false;
+
+    // BFS scratch, sized once per grid size and reused between calls
+    std::vector<int> dist;
+    std::vector<uint8_t> owner;
+    std::vector<uint32_t> stamp;
+    std::vector<int> queue;
+    uint32_t generation = 0;
+};
+
+#endif // TRON_BOT_HPP
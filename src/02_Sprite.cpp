@@ -1,4 +1,5 @@
 #include <SFML/Graphics.hpp>
+#include "Animation.hpp"
 
 int main()
 {
@@ -17,12 +18,16 @@ int main()
     sf::Sprite sprite(texture);
     sprite.setPosition(400, 300);
 
+    // Los clips (frames y tiempo entre frames) se leen de un archivo
+    AnimationLibrary animaciones;
+    if (!animaciones.loadFromFile("assets/anim/clips.txt"))
+    {
+        return -1;
+    }
+    Animator animacion(animaciones.find("pikachu_run"));
+
+    // Un solo reloj avanza todas las animaciones
     sf::Clock clock;
-    float frameTime = 0.1f; // Tiempo entre cada frame en segundos
-    int currentFrame = 0;
-    int numFrames = 4; // Número total de frames en la animación
-    int frameWidth = 32;
-    int frameHeight = 32;
 
     while (window.isOpen())
     {
@@ -37,12 +42,8 @@ int main()
         }
 
         // Actualizar el frame de la animación
-        if (clock.getElapsedTime().asSeconds() >= frameTime)
-        {
-            currentFrame = (currentFrame + 1) % numFrames;
-            sprite.setTextureRect(sf::IntRect((currentFrame * 64)+17, 133, 64, 36));
-            clock.restart();
-        }
+        AnimationClock::global().advance(clock.restart().asSeconds());
+        animacion.apply(sprite);
 
         window.clear();
         window.draw(sprite);
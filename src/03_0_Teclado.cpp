@@ -1,4 +1,5 @@
 #include <SFML/Graphics.hpp>
+#include "MotionController.hpp"
 
 class Personaje {
 public:
@@ -8,8 +9,8 @@ public:
         shape.setFillColor(color);
     }
 
-    void move(float offsetX, float offsetY) {
-        shape.move(offsetX, offsetY);
+    void move(const sf::Vector2f& offset) {
+        shape.move(offset);
     }
 
     void draw(sf::RenderWindow& window) {
@@ -20,12 +21,16 @@ private:
     sf::RectangleShape shape;
 };
 
-double velocidad = 0.1;
+float velocidad = 200.f; // pixeles por segundo
 
 int main() {
     sf::RenderWindow window(sf::VideoMode(800, 600), "DinoChrome");
+    // Limitar a 60 FPS: el bucle duerme entre cuadros en lugar de usar el 100% del CPU
+    window.setFramerateLimit(60);
 
     Personaje character(sf::Vector2f(400, 300), sf::Color::Red);
+    MotionController control(velocidad);
+    sf::Clock clock;
 
     while (window.isOpen()) {
         sf::Event event;
@@ -35,18 +40,9 @@ int main() {
             }
         }
 
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left)) {
-            character.move(velocidad * -1, 0);
-        }
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right)) {
-            character.move(velocidad, 0);
-        }
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up)) {
-            character.move(0, velocidad * -1);
-        }
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Down)) {
-            character.move(0, velocidad);
-        }
+        // El movimiento depende del tiempo real del cuadro (dt), no de la velocidad del CPU
+        float dt = clock.restart().asSeconds();
+        character.move(control.step(dt));
 
         window.clear();
         character.draw(window);
@@ -1,9 +1,12 @@
 #include <SFML/Graphics.hpp>
+#include "Animation.hpp"
+#include "MotionController.hpp"
 
 class Personaje
 {
 public:
-    Personaje(sf::Vector2f position, sf::Color color)
+    Personaje(sf::Vector2f position, sf::Color color, const AnimationClip *clip)
+        : animacion(clip)
     {
         shape.setSize(sf::Vector2f(50, 50));
         shape.setPosition(position); // Posición inicial cuadro
@@ -19,10 +22,10 @@ public:
         this->sprite.setPosition(position); // Posición inicial sprite
     }
 
-    void move(float offsetX, float offsetY)
+    void move(const sf::Vector2f &offset)
     {
-        sprite.move(offsetX, offsetY);
-        shape.move(offsetX, offsetY);
+        sprite.move(offset);
+        shape.move(offset);
     }
 
     void draw(sf::RenderWindow &window)
@@ -32,34 +35,34 @@ public:
     }
 
     void update(){
-        // Actualizar el frame de la animación
-        if (clock.getElapsedTime().asSeconds() >= frameTime)
-        {
-            currentFrame = (currentFrame + 1) % numFrames;
-            sprite.setTextureRect(sf::IntRect((currentFrame * 64)+17, 133, 64, 36));
-            clock.restart();
-        }
+        // Actualizar el frame de la animación (usa el reloj global de animación)
+        animacion.apply(sprite);
     }
 
 private:
     sf::RectangleShape shape;
     sf::Sprite sprite;
     sf::Texture texture;
-    sf::Clock clock;
-    float frameTime = 0.1f; // Tiempo entre cada frame en segundos
-    int currentFrame = 0;
-    int numFrames = 4; // Número total de frames en la animación
-    int frameWidth = 32;
-    int frameHeight = 32;
+    Animator animacion;
 };
 
-double velocidad = 0.1;
+float velocidad = 200.f; // pixeles por segundo
 
 int main()
 {
     sf::RenderWindow window(sf::VideoMode(800, 600), "DinoChrome");
+    // Limitar a 60 FPS: el bucle duerme entre cuadros en lugar de usar el 100% del CPU
+    // (window.setVerticalSyncEnabled(true) es la alternativa; no usar ambas a la vez)
+    window.setFramerateLimit(60);
+
+    AnimationLibrary animaciones;
+    animaciones.loadFromFile("assets/anim/clips.txt");
+    Personaje pika(sf::Vector2f(400, 300), sf::Color::Red, animaciones.find("pikachu_run"));
 
-    Personaje pika(sf::Vector2f(400, 300), sf::Color::Red);
+    MotionController control(velocidad);
+
+    // Un solo reloj para todas las animaciones y el movimiento
+    sf::Clock reloj;
 
     while (window.isOpen())
     {
@@ -72,24 +75,12 @@ int main()
             }
         }
 
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left))
-        {
-            pika.move(velocidad * -1, 0);
-        }
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right))
-        {
-            pika.move(velocidad, 0);
-        }
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up))
-        {
-            pika.move(0, velocidad * -1);
-        }
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Down))
-        {
-            pika.move(0, velocidad);
-        }
+        // El movimiento depende del tiempo real del cuadro (dt), no de la velocidad del CPU
+        float dt = reloj.restart().asSeconds();
+        pika.move(control.step(dt));
 
         // Actualizar animacion pikachu
+        AnimationClock::global().advance(dt);
         pika.update();
 
         window.clear();
@@ -4,6 +4,7 @@
 int main()
 {
     sf::RenderWindow window(sf::VideoMode(800, 600), "Reproductor de musica");
+    window.setFramerateLimit(60);
 
     sf::Music music;
     if (!music.openFromFile("./assets/music/musica.ogg"))
@@ -26,15 +27,15 @@ int main()
             }
         }
 
+        // Al terminar la canción la ventana sigue abierta; Espacio la reproduce otra vez
+        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Space) && music.getStatus() != sf::Music::Playing)
+        {
+            music.play();
+        }
+
         window.clear();
         // Dibujar elementos adicionales en la ventana si es necesario
         window.display();
-
-        // Esperar hasta que la música termine
-        if (music.getStatus() != sf::Music::Playing)
-        {
-            window.close();
-        }
     }
 
     return 0;
@@ -1,8 +1,32 @@
 #include <SFML/Graphics.hpp>
+#include "ShapeCache.hpp"
 
 int main()
 {
     sf::RenderWindow window(sf::VideoMode(800, 600), "SFML Window");
+    window.setFramerateLimit(60);
+
+    // Las primitivas se crean una sola vez, fuera del bucle. ShapeCache guarda
+    // sus vertices y solo los recalcula cuando cambia alguna propiedad.
+    ShapeCache escena;
+
+    sf::CircleShape circle(50);
+    circle.setFillColor(sf::Color::Red);
+    circle.setPosition(100, 100);
+    escena.add(circle);
+
+    sf::RectangleShape rectangle(sf::Vector2f(200, 100));
+    rectangle.setFillColor(sf::Color::Green);
+    rectangle.setPosition(300, 200);
+    escena.add(rectangle);
+
+    sf::ConvexShape triangle;
+    triangle.setPointCount(3);
+    triangle.setPoint(0, sf::Vector2f(100, 300));
+    triangle.setPoint(1, sf::Vector2f(200, 300));
+    triangle.setPoint(2, sf::Vector2f(150, 400));
+    triangle.setFillColor(sf::Color::Blue);
+    escena.add(triangle);
 
     while (window.isOpen())
     {
@@ -13,26 +37,13 @@ int main()
                 window.close();
         }
 
+        // Sube a la GPU solo lo que cambio (nada, despues del primer cuadro)
+        escena.update();
+
         window.clear();
 
-        // Dibujar primitivas básicas
-        sf::CircleShape circle(50);
-        circle.setFillColor(sf::Color::Red);
-        circle.setPosition(100, 100);
-        window.draw(circle);
-
-        sf::RectangleShape rectangle(sf::Vector2f(200, 100));
-        rectangle.setFillColor(sf::Color::Green);
-        rectangle.setPosition(300, 200);
-        window.draw(rectangle);
-
-        sf::ConvexShape triangle;
-        triangle.setPointCount(3);
-        triangle.setPoint(0, sf::Vector2f(100, 300));
-        triangle.setPoint(1, sf::Vector2f(200, 300));
-        triangle.setPoint(2, sf::Vector2f(150, 400));
-        triangle.setFillColor(sf::Color::Blue);
-        window.draw(triangle);
+        // Dibujar primitivas básicas (una sola llamada de dibujo)
+        window.draw(escena);
 
         window.display();
     }
@@ -1,29 +1,38 @@
 #include <SFML/Graphics.hpp>
 #include <Box2D/Box2D.h>
 #include <iostream>
+#include "Box2DWorld.hpp"
+#include "RateLimitedLog.hpp"
 using namespace std;
 
 int main()
 {
-    int fuerza = 1;
+    // Fuerza en Newtons aplicada mientras se mantiene presionada una flecha
+    float fuerza = 15.0f;
 
     // Crear una ventana de SFML
     sf::RenderWindow ventana(sf::VideoMode(800, 600), "Ejemplo de Fisica con Box2D y SFML");
+    ventana.setFramerateLimit(60);
 
-    // Crear un mundo de Box2D
-    b2Vec2 vectorGravedad(0.0f, 10.0f);
-    b2World mundo(vectorGravedad);
+    // Crear un mundo de Box2D. La escala convierte pixeles a metros:
+    // con 50 px/m la bola de 25 px de radio mide 0.5 m y el suelo 12 m.
+    Box2DWorld::Settings ajustes;
+    ajustes.pixelsPerMeter = 50.0f;
+    ajustes.timeStep = 1.0f / 60.0f; // paso fijo, independiente de los FPS
+    ajustes.subSteps = 2;            // sub-pasos opcionales para mayor estabilidad
+    Box2DWorld fisica(sf::Vector2f(0.0f, 9.8f * ajustes.pixelsPerMeter), ajustes);
+    b2World& mundo = fisica.world();
 
     // Crear un suelo estático
     b2BodyDef cuerpoSueloDef;
-    cuerpoSueloDef.position.Set(400, 500.0f); // Posición del centro del cuerpo
+    cuerpoSueloDef.position = fisica.toMeters(sf::Vector2f(400.0f, 500.0f)); // Posición del centro del cuerpo
     b2Body* cuerpoSuelo = mundo.CreateBody(&cuerpoSueloDef);
 
     // Crear una forma rectangular
     b2PolygonShape formaSuelo;
     int boxWidth = 600; // 600 pixeles de ancho
     int boxHeight = 10; // 10 pixeles de alto
-    formaSuelo.SetAsBox(boxWidth / 2.0f, boxHeight / 2.0f);
+    formaSuelo.SetAsBox(fisica.toMeters(boxWidth / 2.0f), fisica.toMeters(boxHeight / 2.0f));
 
     // Agregar la forma al cuerpo
     b2FixtureDef fixtureSueloDef;
@@ -34,20 +43,34 @@ int main()
     // Crear un cuerpo dinámico
     b2BodyDef cuerpoBolaDef;
     cuerpoBolaDef.type = b2_dynamicBody;
-    cuerpoBolaDef.position.Set(400.0f, 300.0f);
+    cuerpoBolaDef.position = fisica.toMeters(sf::Vector2f(400.0f, 300.0f));
     b2Body* cuerpoBola = mundo.CreateBody(&cuerpoBolaDef);
 
     // Crear una forma circular
+    float radioBola = 25.0f; // pixeles
     b2CircleShape formaBola;
-    formaBola.m_radius = 25.0f;
+    formaBola.m_radius = fisica.toMeters(radioBola);
 
-    // Agregar la forma al cuerpo
+    // Agregar la forma al cuerpo (densidad de 1 kg/m2, como madera ligera)
     b2FixtureDef fixtureBolaDef;
     fixtureBolaDef.shape = &formaBola;
-    fixtureBolaDef.density = 0.01f;
+    fixtureBolaDef.density = 1.0f;
     fixtureBolaDef.friction = 0.7f;
     cuerpoBola->CreateFixture(&fixtureBolaDef);
 
+    // Las formas de SFML se crean una sola vez; en el bucle solo se mueven
+    sf::RectangleShape suelo(sf::Vector2f(boxWidth, boxHeight));
+    suelo.setOrigin(boxWidth / 2.0f, boxHeight / 2.0f); // El origen x,y está en el centro de la forma
+    suelo.setPosition(fisica.toPixels(cuerpoSuelo->GetPosition()));
+
+    sf::CircleShape bola(radioBola);
+    bola.setOrigin(radioBola, radioBola);
+    bola.setFillColor(sf::Color::Red);
+
+    // Imprime la posicion a lo mucho 4 veces por segundo, sin vaciar la salida en cada cuadro
+    RateLimitedLog log(cout, 0.25f);
+    sf::Clock reloj;
+
     // Bucle principal del juego
     while (ventana.isOpen())
     {
@@ -59,39 +82,30 @@ int main()
                 ventana.close();
         }
 
-        // Controlar la bola con el teclado
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left))
-            cuerpoBola->ApplyLinearImpulse(b2Vec2(-fuerza, 0), cuerpoBola->GetWorldCenter(), true);
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right))
-            cuerpoBola->ApplyLinearImpulse(b2Vec2(fuerza, 0), cuerpoBola->GetWorldCenter(), true);
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up))
-            cuerpoBola->ApplyLinearImpulse(b2Vec2(0, -fuerza), cuerpoBola->GetWorldCenter(), true);
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Down))
-            cuerpoBola->ApplyLinearImpulse(b2Vec2(0, fuerza), cuerpoBola->GetWorldCenter(), true);
-
-        // Actualizar el mundo de Box2D
-        // Ajustar el valor de 1.0 / 60.0 para cambiar la velocidad de la simulación física
-        mundo.Step(1.0f / 60.0f, 6, 2);
-        cout << "Posicion de la bola: " << cuerpoBola->GetPosition().x << ", " << cuerpoBola->GetPosition().y << endl;
+        // Actualizar el mundo de Box2D con el tiempo real transcurrido.
+        // La fuerza del teclado se aplica antes de cada paso fijo.
+        float dt = reloj.restart().asSeconds();
+        fisica.update(dt, [&]() {
+            b2Vec2 empuje(0.0f, 0.0f);
+            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left))  empuje.x -= fuerza;
+            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right)) empuje.x += fuerza;
+            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up))    empuje.y -= fuerza;
+            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Down))  empuje.y += fuerza;
+            cuerpoBola->ApplyForceToCenter(empuje, true);
+        });
+
+        sf::Vector2f posicionBola = fisica.toPixels(cuerpoBola->GetPosition());
+        if (log.ready(dt))
+            log.line() << "Posicion de la bola: " << posicionBola.x << ", " << posicionBola.y << '\n';
 
         // Limpiar la ventana
         ventana.clear();
 
         // Dibujar el suelo
-        sf::RectangleShape suelo(sf::Vector2f(boxWidth, boxHeight));
-        suelo.setOrigin(boxWidth / 2.0f, boxHeight / 2.0f); // El origen x,y está en el centro de la forma
-        suelo.setPosition(
-            cuerpoSuelo->GetPosition().x, 
-            cuerpoSuelo->GetPosition().y);
         ventana.draw(suelo);
 
         // Dibujar la bola
-        sf::CircleShape bola(formaBola.m_radius);
-        bola.setOrigin(formaBola.m_radius, formaBola.m_radius);
-        bola.setFillColor(sf::Color::Red);
-        bola.setPosition(
-            cuerpoBola->GetPosition().x, 
-            cuerpoBola->GetPosition().y);
+        bola.setPosition(posicionBola);
         ventana.draw(bola);
 
         // Mostrar la ventana
@@ -100,4 +114,3 @@ int main()
 
     return 0;
 }
-
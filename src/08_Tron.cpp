@@ -4,6 +4,7 @@
 #include <iostream>
 #include <vector>
 #include <windows.h>
+#include "TronBot.hpp"
 
 #define BLOCKS 90
 #define blockSize 7
@@ -18,6 +19,12 @@ bool gameOver = false;
 int redScore = 0;
 int blueScore = 0;
 
+// Bot control: press 1 / 2 to toggle red / blue between keyboard and bot
+bool redBot = false;
+bool blueBot = true;
+TronBot redAI(std::chrono::milliseconds(2));
+TronBot blueAI(std::chrono::milliseconds(2));
+
 class Player
 {
 public:
@@ -71,9 +78,9 @@ public:
         int y = head.getPosition().y/blockSize;
 
         if(x>=BLOCKS) x = 0;
-        if(x<0) x = BLOCKS;
+        if(x<0) x = BLOCKS-1;
         if(y>=BLOCKS) y = 0;
-        if(y<0) y = BLOCKS;
+        if(y<0) y = BLOCKS-1;
 
         x*=blockSize;
         y*=blockSize;
@@ -133,6 +140,38 @@ public:
         }
     }
 
+    // Bot steering: fills the bot's occupancy grid with both trails and
+    // lets it pick the next direction
+    void ChangeDir(TronBot &bot, const Player &enemy)
+    {
+        TronGrid &grid = bot.Grid();
+        if(grid.Width()!=BLOCKS) grid.Resize(BLOCKS, BLOCKS);
+        else grid.Clear();
+        Mark(grid);
+        enemy.Mark(grid);
+
+        int choice = bot.Decide(HeadCell(grid), DirIndex(), enemy.HeadCell(grid));
+        dir = {kTronDirs[choice].x, kTronDirs[choice].y};
+    }
+
+    void Mark(TronGrid &grid) const
+    {
+        for(int i = 0; i<body.size(); ++i)
+            grid.Set(grid.Index(body[i].getPosition().x/blockSize, body[i].getPosition().y/blockSize), true);
+    }
+
+    int HeadCell(const TronGrid &grid) const
+    {
+        return grid.Index(body[0].getPosition().x/blockSize, body[0].getPosition().y/blockSize);
+    }
+
+    int DirIndex() const
+    {
+        for(int i = 0; i<4; ++i)
+            if(dir.x==kTronDirs[i].x && dir.y==kTronDirs[i].y) return i;
+        return 0;
+    }
+
     void Draw()
     {
         for(int i = 0; i<body.size(); ++i)
@@ -173,6 +212,7 @@ int main()
 
     std::cout << "Red:  " << redScore  << '\n';
     std::cout << "Blue: " << blueScore << '\n';
+    std::cout << "Press '1' / '2' to toggle the red / blue bot\n";
 
     while(window.isOpen())
     {
@@ -180,6 +220,8 @@ int main()
         while(window.pollEvent(e)){
             if(e.type == sf::Event::Closed) window.close();
             if(gameOver && sf::Keyboard::isKeyPressed(sf::Keyboard::R)) main();
+            if(e.type == sf::Event::KeyPressed && e.key.code == sf::Keyboard::Num1) redBot = !redBot;
+            if(e.type == sf::Event::KeyPressed && e.key.code == sf::Keyboard::Num2) blueBot = !blueBot;
         }
 
         sf::Time time = clock.restart();
@@ -187,10 +229,12 @@ int main()
 
         if(!gameOver)
         {
-            p1.ChangeDir(true);
-            p2.ChangeDir(false);
+            if(!redBot)  p1.ChangeDir(true);
+            if(!blueBot) p2.ChangeDir(false);
             if(t>0.03){
                 t = 0;
+                if(redBot)  p1.ChangeDir(redAI, p2);
+                if(blueBot) p2.ChangeDir(blueAI, p1);
                 p1.Update(p2, blueScore);
                 p2.Update(p1, redScore);
             }
@@ -0,0 +1,147 @@
+#include "AllocTracker.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+#include <ostream>
+
+namespace {
+// Plain constant-initialised state: the hooks can run before main() and
+// during static destruction
+thread_local AllocTracker::Scope currentScope = AllocTracker::Other;
+
+struct LiveCounts {
+    std::atomic<unsigned long long> allocs{0};
+    std::atomic<unsigned long long> frees{0};
+    std::atomic<unsigned long long> bytes{0};
+};
+LiveCounts live[AllocTracker::ScopeCount];
+
+AllocTracker::Counts frameStart[AllocTracker::ScopeCount];
+AllocTracker::Counts lastFrameCounts[AllocTracker::ScopeCount];
+AllocTracker::Counts totals[AllocTracker::ScopeCount];
+unsigned long long allocatingFrames[AllocTracker::ScopeCount];
+unsigned long long frameCount = 0;
+
+AllocTracker::Counts snapshot(int s) {
+    AllocTracker::Counts c;
+    c.allocs = live[s].allocs.load(std::memory_order_relaxed);
+    c.frees = live[s].frees.load(std::memory_order_relaxed);
+    c.bytes = live[s].bytes.load(std::memory_order_relaxed);
+    return c;
+}
+}
+
+AllocTracker::ScopeGuard::ScopeGuard(Scope scope) : previous_(currentScope) {
+    currentScope = scope;
+}
+
+AllocTracker::ScopeGuard::~ScopeGuard() {
+    currentScope = previous_;
+}
+
+bool AllocTracker::enabled() {
+#ifdef DUCKHUNT_TRACK_ALLOCS
+    return true;
+#else
+    return false;
+#endif
+}
+
+const char* AllocTracker::scopeName(Scope scope) {
+    static const char* const names[] = {"other", "input", "update", "render", "spawn"};
+    return scope < ScopeCount ? names[scope] : "?";
+}
+
+void AllocTracker::beginFrame() {
+    for (int s = 0; s < ScopeCount; ++s) frameStart[s] = snapshot(s);
+}
+
+void AllocTracker::endFrame() {
+    for (int s = 0; s < ScopeCount; ++s) {
+        Counts now = snapshot(s);
+        Counts& f = lastFrameCounts[s];
+        f.allocs = now.allocs - frameStart[s].allocs;
+        f.frees = now.frees - frameStart[s].frees;
+        f.bytes = now.bytes - frameStart[s].bytes;
+        totals[s].allocs += f.allocs;
+        totals[s].frees += f.frees;
+        totals[s].bytes += f.bytes;
+        if (f.allocs) ++allocatingFrames[s];
+    }
+    ++frameCount;
+}
+
+const AllocTracker::Counts& AllocTracker::lastFrame(Scope scope) {
+    return lastFrameCounts[scope];
+}
+
+const AllocTracker::Counts& AllocTracker::total(Scope scope) {
+    return totals[scope];
+}
+
+unsigned long long AllocTracker::framesAllocating(Scope scope) {
+    return allocatingFrames[scope];
+}
+
+unsigned long long AllocTracker::frames() {
+    return frameCount;
+}
+
+void AllocTracker::resetTotals() {
+    for (int s = 0; s < ScopeCount; ++s) {
+        totals[s] = Counts();
+        allocatingFrames[s] = 0;
+    }
+    frameCount = 0;
+}
+
+void AllocTracker::printSummary(std::ostream& out) {
+    if (!enabled()) {
+        out << "allocation tracking is off (build with make TRACK_ALLOCS=1)\n";
+        return;
+    }
+    out << "allocations over " << frameCount << " frames:\n";
+    const double frames = frameCount ? static_cast<double>(frameCount) : 1.0;
+    for (int s = 0; s < ScopeCount; ++s) {
+        const Counts& t = totals[s];
+        out << "  " << std::left << std::setw(7) << scopeName(static_cast<Scope>(s)) << std::right << std::fixed
+            << std::setprecision(2) << std::setw(10) << t.allocs / frames << " allocs/frame"
+            << std::setw(12) << t.bytes / frames << " bytes/frame"
+            << std::setw(8) << allocatingFrames[s] << " frames allocating\n";
+    }
+}
+
+void AllocTracker::recordAlloc(std::size_t bytes) {
+    LiveCounts& c = live[currentScope];
+    c.allocs.fetch_add(1, std::memory_order_relaxed);
+    c.bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void AllocTracker::recordFree() {
+    live[currentScope].frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+#ifdef DUCKHUNT_TRACK_ALLOCS
+void* operator new(std::size_t size) {
+    AllocTracker::recordAlloc(size);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    AllocTracker::recordAlloc(size);
+    return std::malloc(size ? size : 1);
+}
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept { return operator new(size, tag); }
+
+void operator delete(void* p) noexcept {
+    if (!p) return;
+    AllocTracker::recordFree();
+    std::free(p);
+}
+void operator delete[](void* p) noexcept { operator delete(p); }
+void operator delete(void* p, std::size_t) noexcept { operator delete(p); }
+void operator delete[](void* p, std::size_t) noexcept { operator delete(p); }
+#endif
@@ -0,0 +1,189 @@
+#include "AudioAssets.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ---- MappedFile ----
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    file_ = file;
+    mapping_ = mapping;
+    data_ = view;
+    size_ = static_cast<std::size_t>(size.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // the mapping keeps the file alive
+    if (view == MAP_FAILED) return false;
+    // the stream reads front to back
+    madvise(view, static_cast<std::size_t>(st.st_size), MADV_SEQUENTIAL);
+    data_ = view;
+    size_ = static_cast<std::size_t>(st.st_size);
+#endif
+    return true;
+}
+
+void MappedFile::close() {
+    if (!data_) return;
+#ifdef _WIN32
+    UnmapViewOfFile(data_);
+    CloseHandle(static_cast<HANDLE>(mapping_));
+    CloseHandle(static_cast<HANDLE>(file_));
+    file_ = mapping_ = nullptr;
+#else
+    munmap(data_, size_);
+#endif
+    data_ = nullptr;
+    size_ = 0;
+}
+
+// ---- AudioAssets ----
+
+AudioAssets::~AudioAssets() {
+    if (worker_.joinable()) worker_.join();
+}
+
+void AudioAssets::add(const std::string& name, const std::string& path, Mode mode) {
+    std::unique_ptr<Entry> e(new Entry(name));
+    e->report.name = name;
+    e->report.path = path;
+    e->report.mode = mode;
+    entries_.push_back(std::move(e));
+}
+
+void AudioAssets::startLoading() {
+    if (worker_.joinable() || done_) return;
+    worker_ = std::thread(&AudioAssets::loadAll, this);
+}
+
+void AudioAssets::wait() {
+    if (worker_.joinable()) worker_.join();
+    else if (!done_) loadAll(); // startLoading() was never called
+}
+
+void AudioAssets::loadAll() {
+    for (auto& e : entries_) loadEntry(*e);
+    reportsCache_.clear();
+    for (const auto& e : entries_) reportsCache_.push_back(e->report);
+    done_ = true;
+}
+
+void AudioAssets::loadEntry(Entry& e) {
+    Report& r = e.report;
+    auto t0 = std::chrono::steady_clock::now();
+
+    if (r.mode == Mode::Decoded) {
+        r.loaded = e.buffer.loadFromFile(r.path);
+        if (r.loaded) {
+            r.pcmBytes = static_cast<std::size_t>(e.buffer.getSampleCount()) * sizeof(sf::Int16);
+            r.seconds = e.buffer.getDuration().asSeconds();
+        }
+    } else {
+        // Parse the header once here so a broken file is caught at load time,
+        // not when the music starts
+        sf::InputSoundFile probe;
+        r.loaded = e.mapped.open(r.path) && probe.openFromMemory(e.mapped.data(), e.mapped.size());
+        if (r.loaded) {
+            r.mappedBytes = e.mapped.size();
+            // sf::Music keeps about one second of decoded samples in flight
+            r.pcmBytes = static_cast<std::size_t>(probe.getSampleRate()) * probe.getChannelCount() * sizeof(sf::Int16);
+            r.seconds = probe.getDuration().asSeconds();
+        } else {
+            e.mapped.close();
+        }
+    }
+
+    r.loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    // mapped pages are file-backed and only resident once read, so this is an upper bound
+    e.memory.set(r.pcmBytes + r.mappedBytes, 0);
+    if (!r.loaded) std::cerr << "Warning: could not load audio '" << r.path << "'\n";
+}
+
+const AudioAssets::Entry* AudioAssets::find(const std::string& name) const {
+    if (!done_) return nullptr;
+    for (const auto& e : entries_)
+        if (e->report.name == name) return e.get();
+    return nullptr;
+}
+
+const sf::SoundBuffer* AudioAssets::sound(const std::string& name) const {
+    const Entry* e = find(name);
+    if (!e || !e->report.loaded || e->report.mode != Mode::Decoded) return nullptr;
+    return &e->buffer;
+}
+
+bool AudioAssets::openMusic(const std::string& name, sf::Music& music) const {
+    const Entry* e = find(name);
+    if (!e || !e->report.loaded || e->report.mode != Mode::Streamed) return false;
+    return music.openFromMemory(e->mapped.data(), e->mapped.size());
+}
+
+std::size_t AudioAssets::totalPcmBytes() const {
+    std::size_t total = 0;
+    for (const Report& r : reportsCache_) total += r.pcmBytes;
+    return total;
+}
+
+std::size_t AudioAssets::totalMappedBytes() const {
+    std::size_t total = 0;
+    for (const Report& r : reportsCache_) total += r.mappedBytes;
+    return total;
+}
+
+void AudioAssets::printReport(std::ostream& out) const {
+    out << "audio assets:\n";
+    for (const Report& r : reportsCache_) {
+        out << "  " << std::left << std::setw(8) << r.name
+            << (r.mode == Mode::Decoded ? " decoded " : " streamed")
+            << std::right << std::fixed << std::setprecision(2)
+            << std::setw(9) << r.loadMs << " ms"
+            << std::setw(8) << r.seconds << " s"
+            << std::setw(10) << r.pcmBytes / 1024 << " KiB pcm"
+            << std::setw(10) << r.mappedBytes / 1024 << " KiB mapped"
+            << (r.loaded ? "" : "  (missing)") << '\n';
+    }
+    out << "  total " << totalPcmBytes() / 1024 << " KiB pcm, " << totalMappedBytes() / 1024 << " KiB mapped\n";
+    out.unsetf(std::ios::floatfield);
+    out << std::setprecision(6);
+}
@@ -0,0 +1,121 @@
+#include "AudioEngine.h"
+#include "AudioAssets.h"
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+const unsigned SAMPLE_RATE = 44100;
+const float TWO_PI = 6.2831853f;
+
+// Voices per effect; must add up to AudioEngine::VOICES
+const std::size_t VOICES_PER_SFX[] = {6, 5, 5}; // Shot, Quack, Fall
+const char* const SFX_NAMES[] = {"shot", "quack", "fall"};
+
+// Fallback effects, generated when the file is missing
+std::vector<sf::Int16> makeShot() {
+    std::vector<sf::Int16> s(SAMPLE_RATE / 4);
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<float> noise(-1.f, 1.f);
+    for (std::size_t i = 0; i < s.size(); ++i) {
+        float t = static_cast<float>(i) / SAMPLE_RATE;
+        s[i] = static_cast<sf::Int16>(noise(gen) * std::exp(-t * 25.f) * 28000.f);
+    }
+    return s;
+}
+
+std::vector<sf::Int16> makeQuack() {
+    std::vector<sf::Int16> s(SAMPLE_RATE * 18 / 100);
+    float phase = 0.f;
+    for (std::size_t i = 0; i < s.size(); ++i) {
+        float t = static_cast<float>(i) / SAMPLE_RATE;
+        float freq = 420.f - 900.f * t + 30.f * std::sin(TWO_PI * 35.f * t);
+        phase += freq / SAMPLE_RATE;
+        phase -= std::floor(phase);
+        float saw = 2.f * phase - 1.f;
+        float env = std::min(1.f, t * 200.f) * std::exp(-t * 8.f);
+        s[i] = static_cast<sf::Int16>(saw * env * 14000.f);
+    }
+    return s;
+}
+
+std::vector<sf::Int16> makeFall() {
+    std::vector<sf::Int16> s(SAMPLE_RATE * 7 / 10);
+    float phase = 0.f;
+    for (std::size_t i = 0; i < s.size(); ++i) {
+        float t = static_cast<float>(i) / SAMPLE_RATE;
+        float freq = 1400.f - 1300.f * t;
+        phase += TWO_PI * freq / SAMPLE_RATE;
+        float env = std::min(1.f, t * 50.f) * (1.f - t / 0.7f);
+        s[i] = static_cast<sf::Int16>(std::sin(phase) * env * 9000.f);
+    }
+    return s;
+}
+}
+
+AudioEngine::AudioEngine() {
+    std::size_t next = 0;
+    for (std::size_t i = 0; i < groups_.size(); ++i) {
+        groups_[i].first = next;
+        groups_[i].count = VOICES_PER_SFX[i];
+        next += VOICES_PER_SFX[i];
+    }
+}
+
+void AudioEngine::registerAssets(AudioAssets& assets) {
+    for (const char* name : SFX_NAMES)
+        assets.add(name, std::string("./assets/sounds/") + name + ".wav", AudioAssets::Mode::Decoded);
+}
+
+void AudioEngine::load(const AudioAssets& assets) {
+    // bind every voice to its effect's buffer once, here, instead of in play()
+    for (std::size_t i = 0; i < groups_.size(); ++i) {
+        const sf::SoundBuffer* buffer = assets.sound(SFX_NAMES[i]);
+        if (!buffer) {
+            std::cerr << "Warning: could not load sound '" << SFX_NAMES[i] << "', using a generated one\n";
+            buffer = &generate(static_cast<Sfx>(i));
+        }
+        const Group& g = groups_[i];
+        for (std::size_t v = g.first; v < g.first + g.count; ++v) voices_[v].setBuffer(*buffer);
+    }
+}
+
+const sf::SoundBuffer& AudioEngine::generate(Sfx id) {
+    sf::SoundBuffer& buffer = generated_[static_cast<std::size_t>(id)];
+    std::vector<sf::Int16> samples;
+    switch (id) {
+    case Sfx::Shot:  samples = makeShot(); break;
+    case Sfx::Quack: samples = makeQuack(); break;
+    case Sfx::Fall:  samples = makeFall(); break;
+    default: return buffer;
+    }
+    buffer.loadFromSamples(samples.data(), samples.size(), 1, SAMPLE_RATE);
+    std::size_t bytes = 0;
+    for (const sf::SoundBuffer& b : generated_) bytes += static_cast<std::size_t>(b.getSampleCount()) * sizeof(sf::Int16);
+    generatedMemory_.set(bytes, 0);
+    return buffer;
+}
+
+void AudioEngine::play(Sfx id, float volume, float pitch) {
+    const Group& g = groups_[static_cast<std::size_t>(id)];
+    if (g.count == 0) return;
+
+    // a free voice if there is one, otherwise the oldest in the group
+    std::size_t pick = g.first;
+    for (std::size_t v = g.first; v < g.first + g.count; ++v) {
+        if (voices_[v].getStatus() != sf::Sound::Playing) {
+            pick = v;
+            break;
+        }
+        if (startedAt_[v] < startedAt_[pick]) pick = v;
+    }
+
+    sf::Sound& voice = voices_[pick];
+    voice.stop();
+    voice.setVolume(volume * masterVolume_ / 100.f);
+    voice.setPitch(pitch);
+    voice.play();
+    startedAt_[pick] = ++playCounter_;
+}
@@ -1,20 +1,22 @@
 #include "../include/Duck.h"
+#include "../include/DuckPhysics.h"
+#include "../include/Random.h"
 
-#include <random>
 #include <cmath>
+#include <algorithm>
 #include <iostream>
+#include <map>
 
-static float randRange(float a, float b) {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_real_distribution<float> dist(a, b);
-    return dist(gen);
-}
-
-Duck::Duck(const sf::Vector2f& startPos, const sf::Vector2u& windowSize, const std::string& texturePath)
+Duck::Duck(const sf::Vector2f& startPos, const sf::Vector2u& windowSize, const std::string& texturePath,
+           const AnimationClip* flapClip)
     : vx_(0.f), vy_(0.f), baseY_(startPos.y), amplitude_(20.f), frequency_(2.f), time_(0.f), windowSize_(windowSize)
 {
-    ensureTextureLoaded(texturePath);
+    ensureTextureLoaded(texturePath, flapClip);
+    if (hasTexture_ && flapClip && !flapClip->frames.empty()) {
+        // random phase so ducks don't flap in sync
+        flap_.setClip(flapClip, randRange(0.f, flapClip->duration()));
+        flap_.apply(*sprite_);
+    }
 
     if (hasTexture_ && sprite_) sprite_->setPosition(startPos);
     else placeholder_.setPosition(startPos);
@@ -37,9 +39,113 @@ Duck::Duck(const sf::Vector2f& startPos, const sf::Vector2u& windowSize, const s
     }
 }
 
-Duck::~Duck() {}
+Duck::~Duck() {
+    releaseBody();
+}
+
+void Duck::releaseBody() {
+    if (physics_ && body_) physics_->destroyBody(body_);
+    body_ = nullptr;
+}
+
+// Builds the frames of a wing-flap clip from a single duck image. Every frame
+// is the image box-filtered down to the clip's frame size, with the upper half
+// (the wings) squashed towards the body by a different amount per frame.
+static sf::Image buildFlapSheet(const sf::Image& src, const AnimationClip& clip) {
+    int sheetW = 0, sheetH = 0;
+    for (const sf::IntRect& r : clip.frames) {
+        sheetW = std::max(sheetW, r.left + r.width);
+        sheetH = std::max(sheetH, r.top + r.height);
+    }
+    sf::Image sheet;
+    sheet.create(static_cast<unsigned>(sheetW), static_cast<unsigned>(sheetH), sf::Color::Transparent);
+
+    const unsigned sw = src.getSize().x, sh = src.getSize().y;
+    const sf::Uint8* px = src.getPixelsPtr();
+    if (!px) return sheet;
+    const size_t n = clip.frames.size();
+
+    for (size_t f = 0; f < n; ++f) {
+        const sf::IntRect& r = clip.frames[f];
+        if (r.width <= 0 || r.height <= 0) continue;
+        // 1 = wings up, about 0.65 half-way through the cycle
+        const float squash = 1.f - 0.35f * 0.5f * (1.f - std::cos(6.2831853f * static_cast<float>(f) / static_cast<float>(n)));
+        const float mid = r.height / 2.f;
+
+        for (int y = 0; y < r.height; ++y) {
+            float fy0 = static_cast<float>(y), fy1 = static_cast<float>(y + 1);
+            if (fy1 <= mid) {
+                fy0 = mid - (mid - fy0) / squash;
+                fy1 = mid - (mid - fy1) / squash;
+            }
+            if (fy1 <= 0.f) continue; // above the squashed wings: stays transparent
+            fy0 = std::max(fy0, 0.f);
+            unsigned sy0 = std::min(sh - 1, static_cast<unsigned>(fy0 * sh / r.height));
+            unsigned sy1 = std::min(sh, std::max(sy0 + 1, static_cast<unsigned>(fy1 * sh / r.height)));
+
+            for (int x = 0; x < r.width; ++x) {
+                unsigned sx0 = std::min(sw - 1, static_cast<unsigned>(x) * sw / r.width);
+                unsigned sx1 = std::min(sw, std::max(sx0 + 1, static_cast<unsigned>(x + 1) * sw / r.width));
+
+                // alpha-weighted average so transparent pixels don't darken the edges
+                float cr = 0.f, cg = 0.f, cb = 0.f, ca = 0.f;
+                for (unsigned sy = sy0; sy < sy1; ++sy) {
+                    const sf::Uint8* row = px + (static_cast<size_t>(sy) * sw + sx0) * 4;
+                    for (unsigned sx = sx0; sx < sx1; ++sx, row += 4) {
+                        float a = row[3];
+                        cr += row[0] * a; cg += row[1] * a; cb += row[2] * a; ca += a;
+                    }
+                }
+                if (ca <= 0.f) continue;
+                const float count = static_cast<float>((sy1 - sy0) * (sx1 - sx0));
+                sheet.setPixel(static_cast<unsigned>(r.left + x), static_cast<unsigned>(r.top + y),
+                               sf::Color(static_cast<sf::Uint8>(cr / ca), static_cast<sf::Uint8>(cg / ca),
+                                         static_cast<sf::Uint8>(cb / ca), static_cast<sf::Uint8>(ca / count + 0.5f)));
+            }
+        }
+    }
+    return sheet;
+}
+
+sf::Image Duck::keyAndFlip(const sf::Image& source) {
+    sf::Image image = source;
+    // apply simple color-keying by luminance to remove bright background
+    unsigned int w = image.getSize().x;
+    unsigned int h = image.getSize().y;
+    const float KEY_HIGH = 250.f;
+    const float KEY_LOW  = 200.f;
 
-void Duck::ensureTextureLoaded(const std::string& path) {
+    for (unsigned int y = 0; y < h; ++y) {
+        for (unsigned int x = 0; x < w; ++x) {
+            sf::Color c = image.getPixel(x, y);
+            float lum = 0.2126f * c.r + 0.7152f * c.g + 0.0722f * c.b;
+            if (lum >= KEY_HIGH) {
+                c.a = 0;
+                image.setPixel(x, y, c);
+            } else if (lum > KEY_LOW) {
+                float t = (KEY_HIGH - lum) / (KEY_HIGH - KEY_LOW);
+                if (t < 0.f) t = 0.f; if (t > 1.f) t = 1.f;
+                c.a = static_cast<uint8_t>(c.a * t + 0.5f);
+                image.setPixel(x, y, c);
+            }
+        }
+    }
+
+    // flip horizontally so sprite faces right by default
+    sf::Image flipped;
+    flipped.create(w, h, sf::Color::Transparent);
+    for (unsigned int y = 0; y < h; ++y) {
+        for (unsigned int x = 0; x < w; ++x) {
+            sf::Color px = image.getPixel(x, y);
+            flipped.setPixel(w - 1 - x, y, px);
+        }
+    }
+    return flipped;
+}
+
+// Decode, key and flip the duck image (or draw a placeholder one) and build
+// its texture and hit mask. Returns nullptr when neither is possible.
+std::shared_ptr<const Duck::Art> Duck::loadArt(const std::string& path, const AnimationClip* flapClip) {
     sf::Image image;
     bool loaded = image.loadFromFile(path);
 
@@ -77,42 +183,32 @@ void Duck::ensureTextureLoaded(const std::string& path) {
         }
     }
 
-    if (loaded) {
-        // apply simple color-keying by luminance to remove bright background
-        unsigned int w = image.getSize().x;
-        unsigned int h = image.getSize().y;
-        const float KEY_HIGH = 250.f;
-        const float KEY_LOW  = 200.f;
-
-        for (unsigned int y = 0; y < h; ++y) {
-            for (unsigned int x = 0; x < w; ++x) {
-                sf::Color c = image.getPixel(x, y);
-                float lum = 0.2126f * c.r + 0.7152f * c.g + 0.0722f * c.b;
-                if (lum >= KEY_HIGH) {
-                    c.a = 0;
-                    image.setPixel(x, y, c);
-                } else if (lum > KEY_LOW) {
-                    float t = (KEY_HIGH - lum) / (KEY_HIGH - KEY_LOW);
-                    if (t < 0.f) t = 0.f; if (t > 1.f) t = 1.f;
-                    c.a = static_cast<uint8_t>(c.a * t + 0.5f);
-                    image.setPixel(x, y, c);
-                }
-            }
-        }
+    if (!loaded) return nullptr;
 
-        // flip horizontally so sprite faces right by default
-        sf::Image flipped;
-        flipped.create(w, h, sf::Color::Transparent);
-        for (unsigned int y = 0; y < h; ++y) {
-            for (unsigned int x = 0; x < w; ++x) {
-                sf::Color px = image.getPixel(x, y);
-                flipped.setPixel(w - 1 - x, y, px);
-            }
-        }
+    sf::Image flipped = keyAndFlip(image);
+    std::shared_ptr<Art> art = std::make_shared<Art>("art " + path);
+    const sf::Image& sheet = flapClip && !flapClip->frames.empty() ? buildFlapSheet(flipped, *flapClip) : flipped;
+    art->texture.loadFromImage(sheet);
+    art->texture.setSmooth(true);
+    art->mask.build(sheet);
+    art->memory.set(art->mask.bytes(), MemoryLedger::textureBytes(art->texture));
+    return art;
+}
 
-        texture_.loadFromImage(flipped);
-        texture_.setSmooth(true);
-        sprite_.reset(new sf::Sprite(texture_));
+void Duck::ensureTextureLoaded(const std::string& path, const AnimationClip* flapClip) {
+    // Ducks built from the same image and clip share one texture and mask;
+    // the cache only holds weak references, so the art goes away with the last duck
+    static std::map<std::pair<std::string, const AnimationClip*>, std::weak_ptr<const Art>> cache;
+    std::weak_ptr<const Art>& cached = cache[std::make_pair(path, flapClip)];
+    art_ = cached.lock();
+    if (!art_) {
+        art_ = loadArt(path, flapClip);
+        cached = art_;
+    }
+
+    if (art_) {
+        sprite_.reset(new sf::Sprite(art_->texture));
+        if (flapClip && !flapClip->frames.empty()) sprite_->setTextureRect(flapClip->frames[0]);
         auto b = sprite_->getLocalBounds();
         sprite_->setOrigin({b.width / 2.f, b.height / 2.f});
 
@@ -133,10 +229,64 @@ void Duck::ensureTextureLoaded(const std::string& path) {
     }
 }
 
+void Duck::setLod(Lod lod) {
+    if (lod == lod_ || !isAlive_) return;
+    if (lod == Lod::Coarse) {
+        if (isFalling_) return;
+        sf::FloatRect b = getBounds();
+        halfSize_ = sf::Vector2f(b.width / 2.f, b.height / 2.f);
+        coarseX_ = getPosition().x;
+        lod_ = Lod::Coarse;
+        return;
+    }
+
+    // back to Full: place the visual where the path has got to, facing the way it flies
+    sf::Vector2f pos = getPosition();
+    lod_ = Lod::Full;
+    if (hasTexture_ && sprite_) {
+        sprite_->setPosition(pos);
+        auto sc = sprite_->getScale();
+        sprite_->setScale({vx_ < 0.f ? -std::abs(sc.x) : std::abs(sc.x), sc.y});
+        flap_.apply(*sprite_);
+    } else {
+        placeholder_.setPosition(pos);
+    }
+}
+
+void Duck::updateLod(const sf::FloatRect& visible, float margin) {
+    sf::FloatRect nearby(visible.left - margin, visible.top - margin, visible.width + 2.f * margin, visible.height + 2.f * margin);
+    setLod(getBounds().intersects(nearby) ? Lod::Full : Lod::Coarse);
+}
+
+sf::Vector2f Duck::getPosition() const {
+    if (lod_ == Lod::Coarse) return sf::Vector2f(coarseX_, baseY_ + amplitude_ * std::sin(frequency_ * time_));
+    if (hasTexture_) return sprite_ ? sprite_->getPosition() : sf::Vector2f(0.f, 0.f);
+    return placeholder_.getPosition();
+}
+
 void Duck::update(float dt) {
     if (!isAlive_) return;
 
+    if (lod_ == Lod::Coarse) {
+        // same path and wrap-around as below, on plain floats
+        time_ += dt;
+        coarseX_ += vx_ * dt;
+        if (coarseX_ + halfSize_.x < 0.f) {
+            coarseX_ = halfSize_.x;
+            vx_ = std::abs(vx_);
+        } else if (coarseX_ - halfSize_.x > static_cast<float>(windowSize_.x)) {
+            coarseX_ = static_cast<float>(windowSize_.x) - halfSize_.x;
+            vx_ = -std::abs(vx_);
+        }
+        return;
+    }
+
     if (isFalling_) {
+        if (body_) {
+            updateFromBody(dt);
+            return;
+        }
+
         const float gravity = 800.f;
         vy_ += gravity * dt;
         if (hasTexture_ && sprite_) {
@@ -154,6 +304,7 @@ void Duck::update(float dt) {
     }
 
     time_ += dt;
+    if (sprite_) flap_.apply(*sprite_);
     float curX = hasTexture_ && sprite_ ? sprite_->getPosition().x : placeholder_.getPosition().x;
     float newX = curX + vx_ * dt;
     float newY = baseY_ + amplitude_ * std::sin(frequency_ * time_);
@@ -180,24 +331,101 @@ void Duck::update(float dt) {
     }
 }
 
-void Duck::draw(sf::RenderWindow& window) const {
-    if (!isAlive_) return;
+void Duck::updateFromBody(float dt) {
+    sf::Vector2f pos = physics_->toPixels(body_->GetPosition());
+    float angle = body_->GetAngle() * 57.2957795f;
+    if (hasTexture_ && sprite_) {
+        sprite_->setPosition(pos);
+        sprite_->setRotation(angle);
+    } else {
+        placeholder_.setPosition(pos);
+        placeholder_.setRotation(angle);
+    }
+
+    // Sleeping bodies have come to rest on the pile; clear them after a while
+    if (body_->IsAwake()) {
+        restTime_ = 0.f;
+    } else {
+        restTime_ += dt;
+        float lifetime = physics_->corpseLifetime();
+        if (lifetime >= 0.f && restTime_ >= lifetime) {
+            isAlive_ = false;
+            releaseBody();
+            return;
+        }
+    }
+
+    if (pos.y > static_cast<float>(windowSize_.y) + 64.f) {
+        isAlive_ = false;
+        releaseBody();
+    }
+}
+
+void Duck::draw(sf::RenderTarget& target) const {
+    if (!isAlive_ || lod_ == Lod::Coarse) return;
     if (hasTexture_) {
-        if (sprite_) window.draw(*sprite_);
+        if (sprite_) target.draw(*sprite_);
     } else {
-        window.draw(placeholder_);
+        target.draw(placeholder_);
     }
 }
 
+bool Duck::snapshot(RenderSnapshot::Sprite& out) const {
+    if (!isAlive_ || lod_ == Lod::Coarse) return false;
+    if (hasTexture_) {
+        if (!sprite_ || !art_) return false;
+        out.texture = std::shared_ptr<const sf::Texture>(art_, &art_->texture);
+        out.rect = sprite_->getTextureRect();
+        out.transform = sprite_->getTransform();
+    } else {
+        out.texture.reset();
+        out.transform = placeholder_.getTransform();
+        out.size = placeholder_.getSize();
+        out.color = placeholder_.getFillColor();
+    }
+    return true;
+}
+
 sf::FloatRect Duck::getBounds() const {
+    if (lod_ == Lod::Coarse) {
+        sf::Vector2f pos = getPosition();
+        return sf::FloatRect(pos.x - halfSize_.x, pos.y - halfSize_.y, 2.f * halfSize_.x, 2.f * halfSize_.y);
+    }
     if (hasTexture_) return sprite_ ? sprite_->getGlobalBounds() : sf::FloatRect();
     return placeholder_.getGlobalBounds();
 }
 
-void Duck::onShot() {
+bool Duck::hitTest(const sf::Vector2f& point) const {
+    if (!getBounds().contains(point)) return false;
+    if (!hasTexture_ || !sprite_ || !art_ || lod_ == Lod::Coarse) return true;
+
+    // into sprite-local space (undoes position, rotation and scale), then texels of the current frame
+    sf::Vector2f local = sprite_->getInverseTransform().transformPoint(point);
+    sf::IntRect rect = sprite_->getTextureRect();
+    int tx = static_cast<int>(std::floor(local.x));
+    int ty = static_cast<int>(std::floor(local.y));
+    if (tx < 0 || ty < 0 || tx >= std::abs(rect.width) || ty >= std::abs(rect.height)) return false;
+    return art_->mask.test(rect.left + tx, rect.top + ty);
+}
+
+void Duck::onShot(DuckPhysics* physics) {
     if (!isAlive_ || isFalling_) return;
+    setLod(Lod::Full);
     isFalling_ = true;
     vy_ = -200.f;
     vx_ *= 0.25f;
+
+    if (physics) {
+        // body matches the unrotated sprite box
+        sf::FloatRect local = hasTexture_ && sprite_ ? sprite_->getLocalBounds() : placeholder_.getLocalBounds();
+        sf::Vector2f scale = hasTexture_ && sprite_ ? sprite_->getScale() : placeholder_.getScale();
+        sf::Vector2f half(local.width * std::abs(scale.x) / 2.f, local.height * std::abs(scale.y) / 2.f);
+        sf::Vector2f pos = hasTexture_ && sprite_ ? sprite_->getPosition() : placeholder_.getPosition();
+        float rotation = hasTexture_ && sprite_ ? sprite_->getRotation() : placeholder_.getRotation();
+        float spin = vx_ < 0.f ? -200.f : 200.f;
+
+        physics_ = physics;
+        body_ = physics->createDuckBody(pos, half, rotation, {vx_, vy_}, spin);
+    }
 }
 
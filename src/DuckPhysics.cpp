@@ -0,0 +1,80 @@
+#include "DuckPhysics.h"
+
+namespace {
+const float DEG_PER_RAD = 57.2957795f;
+
+Box2DWorld::Settings duckSettings() {
+    Box2DWorld::Settings s;
+    s.pixelsPerMeter = DuckPhysics::PIXELS_PER_METER;
+    s.timeStep = DuckPhysics::TIME_STEP;
+    return s;
+}
+}
+
+DuckPhysics::DuckPhysics(const sf::Vector2f& fieldSize, float groundY)
+    : world_(sf::Vector2f(0.f, 800.f), duckSettings()) // same 800 px/s^2 the old hand-rolled fall used
+{
+    b2BodyDef groundDef;
+    groundDef.position.Set(0.f, 0.f);
+    ground_ = world_.world().CreateBody(&groundDef);
+
+    // Grass: a thick slab whose top edge is at groundY
+    const float w = toMeters(fieldSize.x);
+    const float h = toMeters(fieldSize.y);
+    const float top = toMeters(groundY);
+    const float slab = 1.f;
+    b2PolygonShape grass;
+    grass.SetAsBox(w, slab, b2Vec2(w / 2.f, top + slab), 0.f);
+    b2FixtureDef grassDef;
+    grassDef.shape = &grass;
+    grassDef.friction = 0.8f;
+    ground_->CreateFixture(&grassDef);
+
+    // Side walls just outside the view keep the pile on screen
+    const float margin = toMeters(64.f);
+    b2PolygonShape wall;
+    wall.SetAsBox(slab, h, b2Vec2(-margin - slab, top - h), 0.f);
+    ground_->CreateFixture(&wall, 0.f);
+    wall.SetAsBox(slab, h, b2Vec2(w + margin + slab, top - h), 0.f);
+    ground_->CreateFixture(&wall, 0.f);
+}
+
+DuckPhysics::~DuckPhysics() {}
+
+b2Body* DuckPhysics::createDuckBody(const sf::Vector2f& position, const sf::Vector2f& halfSize, float angleDeg,
+                                    const sf::Vector2f& velocity, float angularVelocityDeg) {
+    b2BodyDef def;
+    def.type = b2_dynamicBody;
+    def.position = world_.toMeters(position);
+    def.angle = angleDeg / DEG_PER_RAD;
+    def.linearVelocity = world_.toMeters(velocity);
+    def.angularVelocity = angularVelocityDeg / DEG_PER_RAD;
+    def.angularDamping = 0.5f;
+    def.allowSleep = true;
+    b2Body* body = world_.world().CreateBody(&def);
+
+    b2PolygonShape box;
+    box.SetAsBox(toMeters(halfSize.x), toMeters(halfSize.y));
+    b2FixtureDef fixture;
+    fixture.shape = &box;
+    fixture.density = 1.f;
+    fixture.friction = 0.6f;
+    fixture.restitution = 0.2f;
+    body->CreateFixture(&fixture);
+    return body;
+}
+
+void DuckPhysics::destroyBody(b2Body* body) {
+    if (body) world_.world().DestroyBody(body);
+}
+
+void DuckPhysics::step(float dt) {
+    world_.update(dt);
+}
+
+int DuckPhysics::awakeBodyCount() const {
+    int n = 0;
+    for (const b2Body* b = world_.world().GetBodyList(); b; b = b->GetNext())
+        if (b->GetType() == b2_dynamicBody && b->IsAwake()) ++n;
+    return n;
+}
@@ -0,0 +1,136 @@
+#include "DynamicResolution.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+DynamicResolution::DynamicResolution(const sf::Vector2f& worldSize, const Settings& settings)
+    : settings_(settings), worldSize_(worldSize), history_(std::max(1u, settings.historySize), 0.f) {
+    windowView_.reset(sf::FloatRect(0.f, 0.f, worldSize.x, worldSize.y));
+    sceneView_ = windowView_;
+    scale_ = settings_.maxScale;
+}
+
+sf::View DynamicResolution::letterbox(const sf::Vector2f& worldSize, const sf::Vector2u& windowSize) {
+    sf::View view(sf::FloatRect(0.f, 0.f, worldSize.x, worldSize.y));
+    if (windowSize.x == 0 || windowSize.y == 0) return view;
+    // uniform fit, centred; the rest of the window becomes bars
+    const sf::Vector2f win(static_cast<float>(windowSize.x), static_cast<float>(windowSize.y));
+    const float fit = std::min(win.x / worldSize.x, win.y / worldSize.y);
+    const sf::Vector2f area(worldSize.x * fit, worldSize.y * fit);
+    view.setViewport(sf::FloatRect((win.x - area.x) / 2.f / win.x, (win.y - area.y) / 2.f / win.y,
+                                   area.x / win.x, area.y / win.y));
+    return view;
+}
+
+bool DynamicResolution::resize(const sf::Vector2u& windowSize) {
+    if (windowSize.x == 0 || windowSize.y == 0) return ok_; // minimised
+
+    windowView_ = letterbox(worldSize_, windowSize);
+    const sf::FloatRect& viewport = windowView_.getViewport();
+    sf::Vector2u pixels(static_cast<unsigned>(std::max(1.f, std::round(viewport.width * windowSize.x))),
+                        static_cast<unsigned>(std::max(1.f, std::round(viewport.height * windowSize.y))));
+    if (pixels != areaSize_ || !ok_) {
+        areaSize_ = pixels;
+        ok_ = scene_.create(pixels.x, pixels.y);
+        memory_.set(0, ok_ ? MemoryLedger::pixelBytes(pixels) : 0);
+        if (!ok_) {
+            std::cerr << "Warning: could not create a " << pixels.x << "x" << pixels.y
+                      << " render texture, drawing at window resolution\n";
+            return false;
+        }
+        scene_.setSmooth(true);
+        sprite_.setTexture(scene_.getTexture(), true);
+    }
+    updateRenderSize();
+    return true;
+}
+
+void DynamicResolution::updateRenderSize() {
+    renderSize_.x = std::max(1u, static_cast<unsigned>(std::lround(areaSize_.x * scale_)));
+    renderSize_.y = std::max(1u, static_cast<unsigned>(std::lround(areaSize_.y * scale_)));
+    renderSize_.x = std::min(renderSize_.x, areaSize_.x);
+    renderSize_.y = std::min(renderSize_.y, areaSize_.y);
+
+    // the world goes into the top-left renderSize_ pixels of the texture...
+    sceneView_.setViewport(sf::FloatRect(0.f, 0.f, static_cast<float>(renderSize_.x) / areaSize_.x,
+                                         static_cast<float>(renderSize_.y) / areaSize_.y));
+    // ...and those pixels are stretched back over the world rectangle
+    sprite_.setTextureRect(sf::IntRect(0, 0, static_cast<int>(renderSize_.x), static_cast<int>(renderSize_.y)));
+    sprite_.setScale(worldSize_.x / renderSize_.x, worldSize_.y / renderSize_.y);
+}
+
+sf::RenderTarget& DynamicResolution::beginScene(sf::RenderTarget& window, const sf::Color& color) {
+    if (!ok_) {
+        window.setView(windowView_);
+        window.clear(color);
+        return window;
+    }
+    scene_.setView(sceneView_);
+    scene_.clear(color);
+    return scene_;
+}
+
+void DynamicResolution::present(sf::RenderTarget& window) {
+    if (!ok_) return;
+    scene_.display();
+    window.setView(windowView_);
+    window.clear(sf::Color::Black);
+    window.draw(sprite_);
+}
+
+void DynamicResolution::setScale(float scale) {
+    adaptive_ = false;
+    scale_ = std::max(0.05f, std::min(scale, 1.f));
+    if (ok_) updateRenderSize();
+}
+
+void DynamicResolution::endFrame(float frameMs) {
+    history_[historyNext_] = frameMs;
+    historyNext_ = (historyNext_ + 1) % history_.size();
+    historyCount_ = std::min(historyCount_ + 1, history_.size());
+
+    if (!adaptive_ || !ok_ || ++sinceAdjust_ < std::max(1u, settings_.adjustEvery)) return;
+    sinceAdjust_ = 0;
+
+    // Over budget: cut the pixel count in proportion (scale is per axis, hence
+    // the square root). Well under: creep back up in small steps, so the
+    // scale does not bounce around the target.
+    const float avg = averageMs(settings_.adjustEvery);
+    float next = scale_;
+    if (avg > settings_.targetMs) next = scale_ * std::sqrt(settings_.targetMs / avg);
+    else if (avg < settings_.targetMs * settings_.raiseBelow) next = scale_ + settings_.raiseStep;
+    next = std::max(settings_.minScale, std::min(next, settings_.maxScale));
+    if (std::abs(next - scale_) < 0.01f) return;
+
+    scale_ = next;
+    ++scaleChanges_;
+    updateRenderSize();
+}
+
+float DynamicResolution::history(std::size_t i) const {
+    if (i >= historyCount_) return 0.f;
+    std::size_t oldest = (historyNext_ + history_.size() - historyCount_) % history_.size();
+    return history_[(oldest + i) % history_.size()];
+}
+
+float DynamicResolution::averageMs(std::size_t n) const {
+    n = std::min(n, historyCount_);
+    if (n == 0) return 0.f;
+    float sum = 0.f;
+    for (std::size_t i = historyCount_ - n; i < historyCount_; ++i) sum += history(i);
+    return sum / static_cast<float>(n);
+}
+
+void DynamicResolution::printSummary(std::ostream& out) const {
+    float worst = 0.f;
+    for (std::size_t i = 0; i < historyCount_; ++i) worst = std::max(worst, history(i));
+    out << std::fixed << std::setprecision(2)
+        << "Render scale " << scale_ << (adaptive_ ? " (adaptive" : " (fixed") << ", target " << settings_.targetMs
+        << " ms): " << renderSize_.x << "x" << renderSize_.y << " of " << areaSize_.x << "x" << areaSize_.y << " px\n"
+        << "  last " << historyCount_ << " frames: mean " << averageMs(historyCount_) << " ms, worst " << worst
+        << " ms; " << scaleChanges_ << " scale changes\n";
+    out.unsetf(std::ios::floatfield);
+    out << std::setprecision(6);
+}
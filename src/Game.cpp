@@ -1,79 +1,186 @@
 #include "Game.h"
+#include "AllocTracker.h"
+#include "Random.h"
 
 #include <SFML/Window.hpp>
 #include <algorithm>
-#include <random>
+#include <chrono>
 #include <iostream>
 #include <SFML/Audio.hpp>
 #ifdef _WIN32
 #include <windows.h>
 #endif
 
-static float randRange(float a, float b) {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_real_distribution<float> dist(a, b);
-    return dist(gen);
+static const float GRASS_HEIGHT = 120.f;
+static const float GAME_OVER_INPUT_DELAY = 1.f; // seconds before a click restarts
+
+// Left click, Enter or Space: start / restart
+static bool isStartInput(const sf::Event& event) {
+    if (event.type == sf::Event::MouseButtonPressed) return event.mouseButton.button == sf::Mouse::Left;
+    if (event.type == sf::Event::KeyPressed) return event.key.code == sf::Keyboard::Enter || event.key.code == sf::Keyboard::Space;
+    return false;
+}
+
+// World-space rectangle seen through the view (view rotation is not used)
+static sf::FloatRect visibleArea(const sf::View& view) {
+    return sf::FloatRect(view.getCenter() - view.getSize() / 2.f, view.getSize());
 }
 
+// Title and instructions while the audio loads. The round starts `seconds`
+// after the screen appeared once loading is done, or earlier on a click.
+// Offscreen runs do not wait for the loader here; startRound() does.
+class Game::InstructionsScene : public Scene {
+public:
+    InstructionsScene(Game& game, float seconds) : game_(game), seconds_(seconds) {}
+
+    void enter() override {
+        elapsed_ = 0.f;
+        started_ = false;
+        game_.text_.hideAll();
+        game_.text_.setVisible(game_.titleText_, true);
+        game_.text_.setVisible(game_.instructionsText_, true);
+        game_.text_.setVisible(game_.loadingText_, true);
+    }
+    void handleEvent(const sf::Event& event) override {
+        if (isStartInput(event) && game_.audioAssets_.ready()) start();
+    }
+    void update(float dt) override {
+        elapsed_ += dt;
+        bool loaded = game_.audioAssets_.ready();
+        if (loaded && !shownReady_) {
+            game_.text_.setString(game_.loadingText_, "CLIC PARA EMPEZAR");
+            shownReady_ = true;
+        }
+        if (elapsed_ >= seconds_ && (loaded || !game_.window_->isInteractive())) start();
+    }
+    void render(RenderSnapshot& frame) override {
+        frame.pond = game_.pondLoaded_;
+        if (game_.fontLoaded_) game_.text_.copyVertices(frame.text);
+    }
+
+private:
+    void start() {
+        if (started_) return;
+        started_ = true;
+        game_.startRound();
+    }
+
+    Game& game_;
+    float seconds_;
+    float elapsed_ = 0.f;
+    bool started_ = false;
+    bool shownReady_ = false;
+};
+
+// GAME OVER until a click (after a short pause, so the shot that lost the
+// last life does not restart right away) starts a new round.
+class Game::GameOverScene : public Scene {
+public:
+    explicit GameOverScene(Game& game) : game_(game) {}
+
+    void enter() override {
+        elapsed_ = 0.f;
+        game_.text_.hideAll();
+        game_.text_.setVisible(game_.gameOverText_, true);
+        if (game_.duckMusic.getStatus() == sf::Music::Playing) game_.duckMusic.stop();
+    }
+    void handleEvent(const sf::Event& event) override {
+        if (elapsed_ >= GAME_OVER_INPUT_DELAY && isStartInput(event)) game_.startRound();
+    }
+    void update(float dt) override {
+        elapsed_ += dt;
+        game_.text_.setVisible(game_.restartText_, elapsed_ >= GAME_OVER_INPUT_DELAY);
+    }
+    void render(RenderSnapshot& frame) override {
+        if (game_.fontLoaded_) game_.text_.copyVertices(frame.text);
+    }
+
+private:
+    Game& game_;
+    float elapsed_ = 0.f;
+};
+
+// The round. Ends with the last life.
+class Game::PlayingScene : public Scene {
+public:
+    explicit PlayingScene(Game& game) : game_(game) {}
+
+    void enter() override {
+        // Only the HUD is on screen during the round
+        game_.text_.hideAll();
+        game_.text_.setVisible(game_.scoreText_, true);
+        game_.text_.setVisible(game_.livesText_, true);
+    }
+    void handleEvent(const sf::Event& event) override {
+        if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
+            game_.shoot(sf::Vector2i(event.mouseButton.x, event.mouseButton.y));
+        }
+    }
+    void update(float dt) override {
+        game_.update(dt);
+        if (game_.gameOver_) game_.scenes_.replace(game_.gameOverScene_.get());
+    }
+    void render(RenderSnapshot& frame) override { game_.render(frame); }
+
+private:
+    Game& game_;
+};
+
 Game::Game(unsigned int width, unsigned int height, const std::string& title)
-    : width_(width), height_(height), title_(title) {
-    window_.create(sf::VideoMode(width_, height_), title_);
-    window_.setFramerateLimit(60);
+    : window_(new GameWindow(width, height, title)), width_(width), height_(height), title_(title),
+      resolution_(sf::Vector2f(static_cast<float>(width), static_cast<float>(height))) {
+}
+
+Game::Game(std::unique_ptr<RenderBackend> backend, const std::string& title)
+    : window_(std::move(backend)), width_(window_->getSize().x), height_(window_->getSize().y), title_(title),
+      resolution_(sf::Vector2f(static_cast<float>(width_), static_cast<float>(height_))) {
+    // nobody watches the frame time of a backend like this, and its frames
+    // should not depend on how fast the machine is
+    if (!window_->isInteractive()) resolution_.setAdaptive(false);
 }
 
 Game::~Game() {
-    if (window_.isOpen()) window_.close();
+    renderThread_.stop();
+    if (window_->isOpen()) window_->close();
 }
 
 bool Game::init() {
-    // Load font (fallback to built-in if missing)
-    if (!font_.loadFromFile("./assets/fonts/Minecraft.ttf")) {
-        std::cerr << "Warning: failed to open font './assets/fonts/Minecraft.ttf'\n";
-        fontLoaded_ = false;
-    } else {
-        fontLoaded_ = true;
-    }
-
-    scoreText_.reset(new sf::Text(std::string("Score: 0"), font_, 24));
-    scoreText_->setFillColor(sf::Color::White);
-    scoreText_->setPosition({10.f, 10.f});
-
-    livesText_.reset(new sf::Text(std::string("Lives: 3"), font_, 24));
-    livesText_->setFillColor(sf::Color::White);
-    livesText_->setPosition({10.f, 40.f});
-    // prepare instructions text (shown before ducks spawn)
-    if (fontLoaded_) {
-        std::string instr = "INSTRUCCIONES:\n"
-            "1. Posicionar el cursor sobre un pato y dar clic izquierdo para disparar.\n"
-            "2. Se cuentan con 3 vidas en total.\n"
-            "3. Se pierde una vida cuando se dispara al aire.\n";
-        instructionsText_.reset(new sf::Text(instr, font_, 20));
-        instructionsText_->setFillColor(sf::Color::White);
-        // add a black outline to improve readability over the background
-        instructionsText_->setOutlineColor(sf::Color::Black);
-        instructionsText_->setOutlineThickness(2.f);
-        sf::FloatRect b = instructionsText_->getLocalBounds();
-        instructionsText_->setOrigin(b.left + b.width / 2.f, b.top + b.height / 2.f);
-        instructionsText_->setPosition(window_.getSize().x / 2.f, window_.getSize().y / 2.f);
-        // prepare the game title to display above the instructions
-        titleText_.reset(new sf::Text(std::string("SHOOTING DUCKS"), font_, 64));
-        titleText_->setFillColor(sf::Color(255, 215, 0));
-        titleText_->setStyle(sf::Text::Bold);
-        sf::FloatRect tb = titleText_->getLocalBounds();
-        titleText_->setOrigin(tb.left + tb.width / 2.f, tb.top + tb.height / 2.f);
-        titleText_->setPosition(window_.getSize().x / 2.f, 60.f);
-        // prepare a loading text centered below the instructions
-        loadingText_.reset(new sf::Text(std::string("CARGANDO..."), font_, 20));
-        loadingText_->setFillColor(sf::Color::White);
-        loadingText_->setOutlineColor(sf::Color::Black);
-        loadingText_->setOutlineThickness(2.f);
-        sf::FloatRect lb = loadingText_->getLocalBounds();
-        loadingText_->setOrigin(lb.left + lb.width / 2.f, lb.top + lb.height / 2.f);
-        // place it below instructions: use instructions center Y + half height + padding
-        float padding = 18.f;
-        loadingText_->setPosition(window_.getSize().x / 2.f, window_.getSize().y / 2.f + (b.height / 2.f) + padding + (lb.height / 2.f));
-    }
+    onResized(window_->getSize());
+
+    // Bake the font at every size the screens use into one glyph atlas.
+    // Outlined styles get a second, pre-rasterised outline glyph set.
+    TextAtlas::FontId minecraft = 0;
+    fontLoaded_ = text_.addFont("./assets/fonts/Minecraft.ttf", minecraft);
+    TextAtlas::StyleId hudStyle = text_.addStyle(minecraft, 24);
+    TextAtlas::StyleId bodyStyle = text_.addStyle(minecraft, 20, false, 2.f);
+    TextAtlas::StyleId titleStyle = text_.addStyle(minecraft, 64, true);
+    TextAtlas::StyleId gameOverStyle = text_.addStyle(minecraft, 72);
+    TextAtlas::StyleId debugStyle = text_.addStyle(minecraft, 14, false, 1.f);
+    text_.bake();
+
+    const sf::Vector2f center(window_->getSize().x / 2.f, window_->getSize().y / 2.f);
+    scoreText_ = text_.add(hudStyle, "Score: 0", {10.f, 10.f});
+    livesText_ = text_.add(hudStyle, "Lives: 3", {10.f, 40.f});
+    std::string instr = "INSTRUCCIONES:\n"
+        "1. Posicionar el cursor sobre un pato y dar clic izquierdo para disparar.\n"
+        "2. Se cuentan con 3 vidas en total.\n"
+        "3. Se pierde una vida cuando se dispara al aire.\n";
+    // black outline improves readability over the background
+    instructionsText_ = text_.add(bodyStyle, instr, center, sf::Color::White, sf::Color::Black, TextAtlas::Align::Center);
+    // the game title above the instructions
+    titleText_ = text_.add(titleStyle, "SHOOTING DUCKS", {center.x, 60.f}, sf::Color(255, 215, 0), sf::Color::Black,
+                           TextAtlas::Align::Center);
+    // loading text centered below the instructions: instructions center Y + half height + padding
+    loadingText_ = text_.add(bodyStyle, "CARGANDO...", center, sf::Color::White, sf::Color::Black, TextAtlas::Align::Center);
+    float padding = 18.f;
+    float instrHeight = text_.getLocalBounds(instructionsText_).height;
+    float loadingHeight = text_.getLocalBounds(loadingText_).height;
+    text_.setPosition(loadingText_, {center.x, center.y + instrHeight / 2.f + padding + loadingHeight / 2.f});
+    gameOverText_ = text_.add(gameOverStyle, "GAME OVER", {center.x, center.y - 20.f}, sf::Color::Red, sf::Color::Black,
+                              TextAtlas::Align::Center);
+    restartText_ = text_.add(bodyStyle, "CLIC PARA JUGAR DE NUEVO - ESC PARA SALIR", {center.x, center.y + 50.f},
+                             sf::Color::White, sf::Color::Black, TextAtlas::Align::Center);
+    memoryText_ = text_.add(debugStyle, "MEMORY", {static_cast<float>(width_) - 250.f, 10.f});
 
     // try to load pond background for instruction screen
     if (pondTexture_.loadFromFile("./assets/images/duck_pond.png")) {
@@ -86,25 +193,36 @@ bool Game::init() {
             pondSprite_.setScale(sx, sy);
         }
         pondLoaded_ = true;
+        pondMemory_.set(0, MemoryLedger::textureBytes(pondTexture_));
     } else {
         pondLoaded_ = false;
         std::cerr << "Warning: could not load './assets/images/duck_pond.png'\n";
     }
 
-    // Show instructions first (blocks input except window close)
-    ShowInstructions(10.f);
+    // grass rectangle, built once (a shape allocates its vertices)
+    grass_.setSize(sf::Vector2f(static_cast<float>(width_), GRASS_HEIGHT));
+    grass_.setFillColor(sf::Color(80, 180, 70));
+    grass_.setPosition({0.f, static_cast<float>(height_) - GRASS_HEIGHT});
+    snapshot_.ducks.reserve(64);
 
-    // Spawn a couple of ducks to start (after instructions)
-    for (int i = 0; i < 2; ++i) spawnDuck();
+    // Animation clips (duck wing flap)
+    animations_.loadFromFile("./assets/anim/clips.txt");
 
-    // Load and play duck background music (best-effort). File: assets/music/duck.mp3
-    if (duckMusic.openFromFile("./assets/music/duck.mp3")) {
-        duckMusic.setLoop(true);
-        duckMusic.setVolume(60.f);
-        duckMusic.play();
-    } else {
-        std::cerr << "Warning: could not open music './assets/music/duck.mp3'\n";
-    }
+    // Physics world for shot ducks: the grass top is the ground
+    physics_.reset(new DuckPhysics(sf::Vector2f(static_cast<float>(width_), static_cast<float>(height_)),
+                                   static_cast<float>(height_) - GRASS_HEIGHT));
+
+    // Audio loads in the background while the instruction screen is up: short
+    // effects are decoded to PCM, the long music track is mapped and streamed
+    AudioEngine::registerAssets(audioAssets_);
+    audioAssets_.add("music", "./assets/music/duck.mp3", AudioAssets::Mode::Streamed);
+    audioAssets_.startLoading();
+
+    // Instructions first. Offscreen backends show them for a single frame.
+    instructionsScene_.reset(new InstructionsScene(*this, window_->isInteractive() ? 10.f : 0.f));
+    playingScene_.reset(new PlayingScene(*this));
+    gameOverScene_.reset(new GameOverScene(*this));
+    scenes_.push(instructionsScene_.get());
 
     running_ = true;
     clock_.restart();
@@ -113,17 +231,197 @@ bool Game::init() {
 
 void Game::run() {
     if (!running_) init();
-    while (window_.isOpen() && !gameOver_) {
-        float dt = clock_.restart().asSeconds();
+    if (useRenderThread_) {
+        // if the render thread cannot take the context, frames are drawn here as usual
+        useRenderThread_ = renderThread_.start(*window_, [this](const RenderSnapshot& frame) {
+            auto t0 = std::chrono::steady_clock::now();
+            draw(frame);
+            resolution_.endFrame(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - t0).count());
+        });
+    }
+    while (keepRunning()) {
+        frame(clock_.restart().asSeconds());
+        window_->pace();
+    }
+    if (renderThread_.running()) {
+        renderThread_.stop();
+        std::cout << "Render thread drew " << renderThread_.drawn() << " of " << renderThread_.published()
+                  << " snapshots\n";
+    }
+    if (window_->isOpen()) window_->close();
+    if (AllocTracker::enabled()) AllocTracker::printSummary(std::cout);
+    resolution_.printSummary(std::cout);
+    if (measureLatency_) {
+        latency_.print(std::cout, latencyLabel());
+        if (!latencyReport_.empty()) latency_.writeJson(latencyReport_, latencyLabel());
+    }
+}
+
+void Game::setFramePacing(unsigned framerateLimit, bool vsync) {
+    framerateLimit_ = framerateLimit;
+    vsync_ = vsync;
+    window_->setFramerateLimit(framerateLimit);
+    window_->setVerticalSync(vsync);
+}
+
+void Game::measureLatency(const std::string& reportPath, int syntheticClicks) {
+    measureLatency_ = true;
+    latencyReport_ = reportPath;
+    syntheticClicks_ = syntheticClicks;
+    nextClick_ = LatencyProbe::Clock::now();
+}
+
+std::string Game::latencyLabel() const {
+    std::string label = window_->isInteractive() ? "window, " : "offscreen, ";
+    label += framerateLimit_ ? std::to_string(framerateLimit_) + " fps cap" : std::string("no fps cap");
+    label += vsync_ ? ", vsync" : ", no vsync";
+    label += useRenderThread_ ? ", render thread" : ", single thread";
+    if (syntheticClicks_ > 0) label += ", synthetic clicks";
+    return label;
+}
+
+void Game::finishLoading() {
+    if (audioLoaded_) return;
+    audioLoaded_ = true;
+    audioAssets_.wait();
+    audioAssets_.printReport(std::cout);
+    audio_.load(audioAssets_);
+
+    // Duck background music (best-effort). File: assets/music/duck.mp3
+    if (!window_->isInteractive()) {
+        // nobody is listening to an offscreen run
+    } else if (audioAssets_.openMusic("music", duckMusic)) {
+        duckMusic.setLoop(true);
+        duckMusic.setVolume(60.f);
+        musicOpen_ = true;
+    } else {
+        std::cerr << "Warning: could not open music './assets/music/duck.mp3'\n";
+    }
+}
+
+void Game::startRound() {
+    finishLoading();
+
+    score_ = 0;
+    playerLives_ = 3;
+    gameOver_ = false;
+    spawnTimer_ = 0.f;
+    ducks_.clear(); // shot ducks hand their bodies back to physics_
+    particles_.clear();
+    // Spawn a couple of ducks to start
+    for (int i = 0; i < 2; ++i) spawnDuck();
+    telemetry_.log(Telemetry::Event::RoundStart, 0.f, 0.f, static_cast<float>(++round_));
+
+    if (musicOpen_ && duckMusic.getStatus() != sf::Music::Playing) duckMusic.play();
+    scenes_.replace(playingScene_.get());
+}
+
+void Game::frame(float dt) {
+    typedef std::chrono::steady_clock Clock;
+    auto ms = [](Clock::time_point from, Clock::time_point to) {
+        return std::chrono::duration<float, std::milli>(to - from).count();
+    };
+    AllocTracker::beginFrame();
+    auto t0 = Clock::now();
+    {
+        AllocTracker::ScopeGuard scope(AllocTracker::Input);
+        scenes_.applyPending(); // transitions asked for during the last frame
         handleInput();
-        update(dt);
-        render();
     }
+    auto t1 = Clock::now();
+    {
+        AllocTracker::ScopeGuard scope(AllocTracker::Update);
+        scenes_.update(dt);
+        updateMemory(dt);
+    }
+    auto t2 = Clock::now();
+    {
+        // The scenes describe the frame; with a render thread, drawing it
+        // overlaps the next tick instead of following this one
+        AllocTracker::ScopeGuard scope(AllocTracker::Render);
+        RenderSnapshot& snapshot = renderThread_.running() ? renderThread_.back() : snapshot_;
+        snapshot.reset();
+        snapshot.windowSize = windowSize_;
+        snapshot.tick = ++tick_;
+        scenes_.render(snapshot);
+        if (renderThread_.running()) renderThread_.publish();
+        else draw(snapshot);
+    }
+    auto t3 = Clock::now();
+    AllocTracker::endFrame();
+
+    lastFrame_.input = ms(t0, t1);
+    lastFrame_.update = ms(t1, t2);
+    lastFrame_.render = ms(t2, t3);
+    if (!renderThread_.running()) resolution_.endFrame(lastFrame_.render); // else timed by the render thread
+    telemetry_.frame(ms(t0, t3), lastFrame_.update, lastFrame_.render, static_cast<std::uint32_t>(ducks_.size()));
+}
 
-    // If the game ended because lives reached 0, show GAME OVER screen
-    if (gameOver_) {
-        ShowGameOver();
+double Game::runFrames(int frames, float dt) {
+    if (!running_) init();
+    auto t0 = std::chrono::steady_clock::now();
+    int done = 0;
+    for (; done < frames && keepRunning(); ++done) frame(dt);
+    window_->finish(); // queued GPU work belongs in the timing
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    return done > 0 ? ms / done : 0.0;
+}
+
+StressReport Game::runStress(const StressSettings& settings) {
+    if (!running_) init();
+
+    StressReport report;
+    report.backend = window_->isInteractive() ? "window" : "offscreen";
+    report.budgetMs = settings.budgetMs;
+    // hold the render scale: lowering it would hide the load being measured
+    resolution_.setScale(resolution_.scale());
+    report.renderScale = resolution_.scale();
+    // straight into a round, without the instructions screen
+    if (scenes_.top() != playingScene_.get()) {
+        startRound();
+        scenes_.applyPending();
+    }
+
+    const float savedInterval = spawnInterval_;
+    const float fixedDt = 1.f / 60.f;
+    std::vector<float> times;
+    times.reserve(static_cast<std::size_t>(settings.holdSeconds / fixedDt) + 1);
+    float rate = settings.startRate;
+    clock_.restart();
+    for (int level = 1; level <= settings.maxLevels && keepRunning() && !gameOver_; ++level, rate *= settings.rateGrowth) {
+        spawnInterval_ = 1.f / rate;
+        StressLevel row;
+        row.level = level;
+        row.spawnRate = rate;
+        row.ducksStart = ducks_.size();
+        times.clear();
+        for (float held = 0.f; held < settings.holdSeconds && keepRunning() && !gameOver_;) {
+            float dt = window_->isInteractive() ? clock_.restart().asSeconds() : fixedDt;
+            frame(dt);
+            window_->pace();
+            times.push_back(lastFrame_.input + lastFrame_.update + lastFrame_.render);
+            row.inputMs += lastFrame_.input;
+            row.updateMs += lastFrame_.update;
+            row.renderMs += lastFrame_.render;
+            held += dt;
+        }
+        if (times.empty()) break;
+
+        row.frames = static_cast<int>(times.size());
+        row.ducksEnd = ducks_.size();
+        row.inputMs /= row.frames;
+        row.updateMs /= row.frames;
+        row.renderMs /= row.frames;
+        row.p50Ms = StressReport::percentile(times, 0.5f);
+        row.p99Ms = StressReport::percentile(times, 0.99f);
+        row.worstMs = times.back(); // sorted by percentile()
+        row.withinBudget = row.p99Ms <= settings.budgetMs;
+        report.levels.push_back(row);
+        if (!row.withinBudget) break;
+        report.maxDucks = row.ducksEnd;
     }
+    spawnInterval_ = savedInterval;
+    return report;
 }
 
 void Game::handleInput() {
@@ -135,7 +433,7 @@ void Game::handleInput() {
         MSG msg;
         while (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE)) {
             if (msg.message == WM_CLOSE) {
-                window_.close();
+                closeRequested_ = true;
                 return;
             }
             TranslateMessage(&msg);
@@ -144,173 +442,252 @@ void Game::handleInput() {
     }
     #endif
 
-    // Poll SFML events and handle input
+    // Poll SFML events: window-level ones here, the rest go to the current scene
     sf::Event event;
-    // if game over, ignore additional input
-    if (gameOver_) return;
-
-    while (window_.pollEvent(event)) {
+    while (window_->pollEvent(event)) {
         if (event.type == sf::Event::Closed) {
-            window_.close();
+            closeRequested_ = true;
             return;
         }
+        if (event.type == sf::Event::Resized) {
+            onResized(sf::Vector2u(event.size.width, event.size.height));
+        }
+        if (event.type == sf::Event::MouseButtonPressed) clickArrived_ = LatencyProbe::Clock::now();
         if (event.type == sf::Event::KeyPressed) {
             if (event.key.code == sf::Keyboard::Escape) {
-                window_.close();
+                closeRequested_ = true;
                 return;
             }
+            if (event.key.code == sf::Keyboard::F3) {
+                accountPools();
+                MemoryLedger::print(std::cout);
+            }
+            if (event.key.code == sf::Keyboard::F4) {
+                showMemory_ = !showMemory_;
+                memoryRefresh_ = 0.f;
+            }
         }
-        if (event.type == sf::Event::MouseButtonPressed) {
-            if (event.mouseButton.button == sf::Mouse::Left) {
-                sf::Vector2i pixelPos(event.mouseButton.x, event.mouseButton.y);
-                sf::Vector2f worldPos = window_.mapPixelToCoords(pixelPos);
-
-                // Check ducks for hit
-                bool anyHit = false;
-                for (auto& dptr : ducks_) {
-                    if (!dptr) continue;
-                    if (!dptr->isAlive()) continue;
-                    if (dptr->isFalling()) continue;
-
-                    if (dptr->getBounds().contains(worldPos)) {
-                        dptr->onShot();
-                        score_ += 100; // simple score rule
-                        anyHit = true;
-                        break; // only one duck per click
-                    }
-                }
-
-                if (!anyHit) {
-                    playerLives_ -= 1;
-                    if (playerLives_ <= 0) {
-                        playerLives_ = 0;
-                        gameOver_ = true;
-                        // stop music optionally
-                        if (duckMusic.getStatus() == sf::Music::Playing) duckMusic.stop();
-                    }
-                }
+        scenes_.handleEvent(event);
+    }
+
+    if (syntheticClicks_ > 0) {
+        if (latency_.count() >= static_cast<std::size_t>(syntheticClicks_)) closeRequested_ = true;
+        else if (LatencyProbe::Clock::now() >= nextClick_) syntheticClick();
+    }
+}
+
+void Game::syntheticClick() {
+    // The click "arrived" when it was due, somewhere in the last frame, like a real one
+    clickArrived_ = nextClick_;
+    const auto gap = std::chrono::duration<float>(randRange(0.25f, 0.45f));
+    nextClick_ = std::max(nextClick_, LatencyProbe::Clock::now()) +
+                 std::chrono::duration_cast<LatencyProbe::Clock::duration>(gap);
+
+    // menus start on a click anywhere; during the round aim at a duck
+    sf::Vector2f target(width_ / 2.f, height_ / 2.f);
+    if (scenes_.top() == playingScene_.get()) {
+        const sf::FloatRect visible = visibleArea(view_);
+        const Duck* duck = nullptr;
+        for (auto& d : ducks_) {
+            if (d && d->isAlive() && !d->isFalling() && visible.contains(d->getPosition())) {
+                duck = d.get();
+                break;
             }
         }
+        if (!duck) return;
+        target = duck->getPosition();
+    }
+
+    const sf::Vector2i pixel = window_->target().mapCoordsToPixel(target, view_);
+    sf::Event event;
+    event.type = sf::Event::MouseButtonPressed;
+    event.mouseButton.button = sf::Mouse::Left;
+    event.mouseButton.x = pixel.x;
+    event.mouseButton.y = pixel.y;
+    scenes_.handleEvent(event);
+}
+
+void Game::shoot(const sf::Vector2i& pixel) {
+    // clicks queued behind the one that lost the last life do not count
+    if (gameOver_) return;
+
+    sf::Vector2f worldPos = window_->target().mapPixelToCoords(pixel, view_);
+    telemetry_.log(Telemetry::Event::Shot, worldPos.x, worldPos.y);
+    audio_.play(Sfx::Shot);
+    particles_.emitMuzzleFlash(worldPos);
+
+    // Check ducks for hit
+    bool anyHit = false;
+    for (auto& dptr : ducks_) {
+        if (!dptr) continue;
+        if (!dptr->isAlive()) continue;
+        if (dptr->isFalling()) continue;
+
+        if (dptr->hitTest(worldPos)) {
+            dptr->onShot(physics_.get());
+            particles_.emitFeathers(dptr->getPosition());
+            audio_.play(Sfx::Quack, 90.f, randRange(0.9f, 1.15f));
+            audio_.play(Sfx::Fall, 50.f);
+            score_ += 100; // simple score rule
+            telemetry_.log(Telemetry::Event::Hit, dptr->getPosition().x, dptr->getPosition().y, static_cast<float>(score_));
+            anyHit = true;
+            break; // only one duck per click
+        }
+    }
+
+    if (!anyHit) {
+        particles_.emitImpact(worldPos);
+        playerLives_ -= 1;
+        if (playerLives_ <= 0) {
+            playerLives_ = 0;
+            gameOver_ = true; // PlayingScene switches to the game over screen
+        }
+        telemetry_.log(Telemetry::Event::Miss, worldPos.x, worldPos.y);
+        telemetry_.log(Telemetry::Event::LifeLost, 0.f, 0.f, static_cast<float>(playerLives_));
+        if (gameOver_) telemetry_.log(Telemetry::Event::GameOver, 0.f, 0.f, static_cast<float>(score_));
     }
+    // the snapshot captured at the end of this frame is the first to show the result
+    if (measureLatency_) latency_.resolved(clickArrived_, tick_ + 1, anyHit);
 }
 
 void Game::update(float dt) {
-    // Spawn control
+    // One shared tick for every animation
+    AnimationClock::global().advance(dt);
+
+    // Spawn control (several per frame when the interval is shorter than a frame)
     spawnTimer_ += dt;
-    if (spawnTimer_ >= spawnInterval_) {
-        spawnTimer_ = 0.f;
+    while (spawnTimer_ >= spawnInterval_) {
+        spawnTimer_ -= spawnInterval_;
         spawnDuck();
     }
 
-    // Update ducks
+    // Step physics first so falling ducks read this frame's body transforms
+    if (physics_) physics_->step(dt);
+
+    // Update ducks; the ones far outside the view only advance their path
+    const sf::FloatRect visible = visibleArea(view_);
     for (auto& d : ducks_) {
-        if (d && d->isAlive()) d->update(dt);
+        if (!d || !d->isAlive()) continue;
+        d->updateLod(visible);
+        d->update(dt);
     }
 
+    // Feathers, flashes and dust
+    particles_.update(dt);
+
     // Remove not-alive ducks
     ducks_.erase(std::remove_if(ducks_.begin(), ducks_.end(), [](const std::unique_ptr<Duck>& d) {
         return !d || !d->isAlive();
     }), ducks_.end());
 
-    // Update HUD texts
-    if (scoreText_) scoreText_->setString(std::string("Score: ") + std::to_string(score_));
-    //if (ammoText_) ammoText_->setString(std::string("Ammo: ") + std::to_string(ammo_));
-    if (livesText_) livesText_->setString(std::string("Lives: ") + std::to_string(playerLives_));
+    // Update HUD texts, only when the value changed: formatting allocates
+    if (score_ != shownScore_) {
+        shownScore_ = score_;
+        text_.setString(scoreText_, std::string("Score: ") + std::to_string(score_));
+    }
+    //text_.setString(ammoText_, std::string("Ammo: ") + std::to_string(ammo_));
+    if (playerLives_ != shownLives_) {
+        shownLives_ = playerLives_;
+        text_.setString(livesText_, std::string("Lives: ") + std::to_string(playerLives_));
+    }
 }
 
-void Game::render() {
-    // Simple background (sky + grass)
-    window_.clear(sf::Color(135, 206, 235)); // sky blue
-
-    // grass rectangle
-    sf::RectangleShape grass(sf::Vector2f(static_cast<float>(width_), 120.f));
-    grass.setFillColor(sf::Color(80, 180, 70));
-    grass.setPosition({0.f, static_cast<float>(height_) - 120.f});
-    window_.draw(grass);
-
-    // Draw ducks
-    for (auto& d : ducks_) if (d) d->draw(window_);
+void Game::onResized(const sf::Vector2u& size) {
+    // resolution_ follows in draw(), on the thread that draws
+    if (size.x == 0 || size.y == 0) return; // minimised
+    windowSize_ = size;
+    view_ = DynamicResolution::letterbox(sf::Vector2f(static_cast<float>(width_), static_cast<float>(height_)), size);
+}
 
-    // Draw HUD
-    if (scoreText_) window_.draw(*scoreText_);
-    //if (ammoText_) window_.draw(*ammoText_);
-    if (livesText_) window_.draw(*livesText_);
+void Game::render(RenderSnapshot& frame) {
+    frame.world = true;
 
-    window_.display();
+    // Ducks, skipping the ones outside the view
+    const sf::FloatRect visible = visibleArea(view_);
+    RenderSnapshot::Sprite sprite;
+    for (auto& d : ducks_) {
+        if (d && d->isVisible(visible) && d->snapshot(sprite)) frame.ducks.push_back(sprite);
+    }
+    frame.particles.assign(particles_.vertices(), particles_.vertices() + particles_.vertexCount());
+    if (fontLoaded_) text_.copyVertices(frame.text);
 }
 
-void Game::spawnDuck() {
-    // spawn at left or right edge, random Y
-    float y = randRange(80.f, static_cast<float>(height_) - 200.f);
-    float x;
-    if (randRange(0.f, 1.f) < 0.5f) {
-        x = -60.f; // start left
+void Game::draw(const RenderSnapshot& frame) {
+    sf::RenderTarget& window = window_->target();
+    if (frame.windowSize != drawnSize_) {
+        drawnSize_ = frame.windowSize;
+        resolution_.resize(drawnSize_);
+    }
+
+    if (frame.world) {
+        // The world goes into the scaled render texture. Simple background (sky + grass)
+        sf::RenderTarget& scene = resolution_.beginScene(window, sf::Color(135, 206, 235)); // sky blue
+        scene.draw(grass_);
+        for (const RenderSnapshot::Sprite& d : frame.ducks) {
+            if (d.texture) {
+                duckSprite_.setTexture(*d.texture);
+                duckSprite_.setTextureRect(d.rect);
+                scene.draw(duckSprite_, d.transform);
+            } else {
+                duckBox_.setSize(d.size);
+                duckBox_.setFillColor(d.color);
+                scene.draw(duckBox_, d.transform);
+            }
+        }
+        if (!frame.particles.empty()) scene.draw(frame.particles.data(), frame.particles.size(), sf::Triangles);
+        // Upscale into the window
+        resolution_.present(window);
     } else {
-        x = static_cast<float>(width_) + 60.f; // start right
+        window.setView(resolution_.windowView());
+        window.clear(frame.clear);
+        if (frame.pond && pondLoaded_) window.draw(pondSprite_);
     }
 
-    ducks_.push_back(std::make_unique<Duck>(sf::Vector2f(x, y), window_.getSize()));
+    // Text on top at full resolution
+    if (!frame.text.empty()) {
+        window.draw(frame.text.data(), frame.text.size(), sf::Triangles, sf::RenderStates(&text_.getTexture()));
+    }
+    window_->display();
+    if (measureLatency_) latency_.presented(frame.tick);
 }
 
-// After the main loop, if the player lost all lives show GAME OVER
-// This renders a full-screen message for 2 seconds.
-void Game::ShowGameOver() {
-    if (!fontLoaded_) {
-        window_.clear(sf::Color::Black);
-        window_.display();
-        sf::sleep(sf::seconds(2.f));
-        return;
+void Game::updateMemory(float dt) {
+    if (MemoryLedger::takeDumpRequest()) {
+        accountPools();
+        MemoryLedger::print(std::cout);
     }
+    text_.setVisible(memoryText_, showMemory_); // scenes hide every text when they start
+    memoryRefresh_ -= dt;
+    if (memoryRefresh_ > 0.f) return;
+    memoryRefresh_ = 0.5f;
+    accountPools();
+    // formatting allocates, so only while the overlay is up
+    if (showMemory_) text_.setString(memoryText_, MemoryLedger::summary());
+}
 
-    sf::Text goText("GAME OVER", font_, 72);
-    goText.setFillColor(sf::Color::Red);
-    auto bounds = goText.getLocalBounds();
-    goText.setOrigin(bounds.width/2.f, bounds.height/2.f);
-    goText.setPosition(static_cast<float>(width_)/2.f, static_cast<float>(height_)/2.f - 20.f);
-
-    window_.clear(sf::Color::Black);
-    window_.draw(goText);
-    window_.display();
-    sf::sleep(sf::seconds(3.f));
+void Game::accountPools() {
+    // Duck objects and their sprites; the shared art has accounts of its own
+    duckPool_.set(ducks_.capacity() * sizeof(std::unique_ptr<Duck>) + ducks_.size() * (sizeof(Duck) + sizeof(sf::Sprite)), 0);
 
+    // The snapshot being filled; with a render thread there are three like it
+    const RenderSnapshot& s = renderThread_.running() ? renderThread_.back() : snapshot_;
+    std::size_t bytes = s.ducks.capacity() * sizeof(RenderSnapshot::Sprite) +
+                        (s.particles.capacity() + s.text.capacity()) * sizeof(sf::Vertex);
+    snapshotMemory_.set(renderThread_.running() ? 3 * bytes : bytes, 0);
 }
 
-void Game::ShowInstructions(float seconds) {
-    if (!fontLoaded_) {
-        // keep window responsive to close events, but otherwise wait
-        sf::Clock c;
-        while (c.getElapsedTime().asSeconds() < seconds) {
-            sf::Event e;
-            while (window_.pollEvent(e)) {
-                if (e.type == sf::Event::Closed) {
-                    window_.close();
-                    return;
-                }
-            }
-            sf::sleep(sf::milliseconds(50));
-        }
-        return;
+void Game::spawnDuck() {
+    AllocTracker::ScopeGuard scope(AllocTracker::Spawn);
+    // spawn at left or right edge, random Y
+    float y = randRange(80.f, static_cast<float>(height_) - 200.f);
+    float x;
+    if (randRange(0.f, 1.f) < 0.5f) {
+        x = -60.f; // start left
+    } else {
+        x = static_cast<float>(width_) + 60.f; // start right
     }
 
-    sf::Clock timer;
-    while (timer.getElapsedTime().asSeconds() < seconds) {
-        sf::Event event;
-        while (window_.pollEvent(event)) {
-            if (event.type == sf::Event::Closed) {
-                window_.close();
-                return;
-            }
-            // ignore other inputs while instructions are shown
-        }
-
-        window_.clear(sf::Color::Black);
-        if (pondLoaded_) window_.draw(pondSprite_);
-        if (titleText_) window_.draw(*titleText_);
-        if (instructionsText_) window_.draw(*instructionsText_);
-        if (loadingText_) window_.draw(*loadingText_);
-        window_.display();
-
-        sf::sleep(sf::milliseconds(16));
-    }
+    ducks_.push_back(std::make_unique<Duck>(sf::Vector2f(x, y), sf::Vector2u(width_, height_), "assets/images/duck.png",
+                                            animations_.find("duck_flap")));
+    telemetry_.log(Telemetry::Event::Spawn, x, y, 0.f, static_cast<std::uint32_t>(ducks_.size()));
 }
-
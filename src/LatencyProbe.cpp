@@ -0,0 +1,115 @@
+#include "LatencyProbe.h"
+#include "StressTest.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+static float msBetween(LatencyProbe::Clock::time_point from, LatencyProbe::Clock::time_point to) {
+    return std::chrono::duration<float, std::milli>(to - from).count();
+}
+
+void LatencyProbe::resolved(Clock::time_point arrived, std::uint64_t tick, bool hit) {
+    Pending click{arrived, Clock::now(), tick, hit};
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.push_back(click);
+}
+
+void LatencyProbe::presented(std::uint64_t tick) {
+    const Clock::time_point now = Clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t kept = 0;
+    for (const Pending& p : pending_) {
+        if (p.tick <= tick) samples_.push_back(Sample{msBetween(p.arrived, p.resolved), msBetween(p.arrived, now), p.hit});
+        else pending_[kept++] = p;
+    }
+    pending_.resize(kept);
+}
+
+std::size_t LatencyProbe::count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return samples_.size();
+}
+
+LatencyProbe::Summary LatencyProbe::summarize() const {
+    std::vector<Sample> samples;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        samples = samples_;
+    }
+    Summary s;
+    s.histogram.assign(BUCKETS, 0);
+    std::vector<float> resolve, display;
+    for (const Sample& sample : samples) {
+        if (sample.hit) ++s.hits;
+        resolve.push_back(sample.resolveMs);
+        display.push_back(sample.displayMs);
+        int bucket = static_cast<int>(sample.displayMs) / BUCKET_MS;
+        ++s.histogram[static_cast<std::size_t>(std::max(0, std::min(bucket, BUCKETS - 1)))];
+    }
+    const float ranks[3] = {0.5f, 0.9f, 0.99f};
+    for (int i = 0; i < 3; ++i) {
+        s.resolve[i] = StressReport::percentile(resolve, ranks[i]);
+        s.display[i] = StressReport::percentile(display, ranks[i]);
+    }
+    s.resolve[3] = resolve.empty() ? 0.f : resolve.back(); // sorted by percentile()
+    s.display[3] = display.empty() ? 0.f : display.back();
+    return s;
+}
+
+void LatencyProbe::print(std::ostream& out, const std::string& label) const {
+    const Summary s = summarize();
+    std::size_t total = 0, peak = 0;
+    for (std::size_t n : s.histogram) {
+        total += n;
+        peak = std::max(peak, n);
+    }
+    out << std::fixed << std::setprecision(2)
+        << "click latency (" << label << "): " << total << " clicks, " << s.hits << " hits\n"
+        << "                        p50     p90     p99     max\n"
+        << "  click -> resolved" << std::setw(8) << s.resolve[0] << std::setw(8) << s.resolve[1]
+        << std::setw(8) << s.resolve[2] << std::setw(8) << s.resolve[3] << " ms\n"
+        << "  click -> display " << std::setw(8) << s.display[0] << std::setw(8) << s.display[1]
+        << std::setw(8) << s.display[2] << std::setw(8) << s.display[3] << " ms\n";
+    if (total > 0) {
+        // bars between the first and the last non-empty bucket
+        std::size_t first = 0, last = s.histogram.size() - 1;
+        while (s.histogram[first] == 0) ++first;
+        while (s.histogram[last] == 0) --last;
+        for (std::size_t b = first; b <= last; ++b) {
+            const std::size_t from = b * BUCKET_MS;
+            if (b + 1 < s.histogram.size()) out << std::setw(5) << from << '-' << std::setw(3) << from + BUCKET_MS << " ms ";
+            else out << std::setw(5) << from << "+    ms ";
+            out << std::setw(6) << s.histogram[b] << ' '
+                << std::string(s.histogram[b] * 40 / peak, '#') << '\n';
+        }
+    }
+    out.unsetf(std::ios::floatfield);
+    out << std::setprecision(6);
+}
+
+bool LatencyProbe::writeJson(const std::string& path, const std::string& label) const {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Warning: could not write '" << path << "'\n";
+        return false;
+    }
+    const Summary s = summarize();
+    std::size_t total = 0;
+    for (std::size_t n : s.histogram) total += n;
+    char line[320];
+    std::snprintf(line, sizeof(line), "{\n  \"label\": \"%s\", \"clicks\": %zu, \"hits\": %zu,\n", label.c_str(), total,
+                  s.hits);
+    out << line;
+    std::snprintf(line, sizeof(line),
+                  "  \"resolve_ms\": {\"p50\": %.3f, \"p90\": %.3f, \"p99\": %.3f, \"max\": %.3f},\n"
+                  "  \"display_ms\": {\"p50\": %.3f, \"p90\": %.3f, \"p99\": %.3f, \"max\": %.3f},\n",
+                  s.resolve[0], s.resolve[1], s.resolve[2], s.resolve[3], s.display[0], s.display[1], s.display[2],
+                  s.display[3]);
+    out << line << "  \"bucket_ms\": " << BUCKET_MS << ", \"display_histogram\": [";
+    for (std::size_t b = 0; b < s.histogram.size(); ++b) out << (b ? ", " : "") << s.histogram[b];
+    out << "]\n}\n";
+    return true;
+}
@@ -0,0 +1,175 @@
+#include "MemoryLedger.h"
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <algorithm>
+#include <csignal>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<const MemoryLedger::Account*> accounts;
+    std::size_t budget = 0;
+    bool warned = false;
+};
+
+// Created on first use, so accounts never see it before it exists
+Registry& registry() {
+    static Registry r;
+    return r;
+}
+
+volatile std::sig_atomic_t dumpRequested = 0;
+
+#ifdef SIGUSR1
+void onDumpSignal(int) { dumpRequested = 1; }
+#endif
+
+double kib(std::size_t bytes) { return static_cast<double>(bytes) / 1024.0; }
+
+} // namespace
+
+MemoryLedger::Account::Account(System system, const std::string& name) : system_(system), name_(name) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.accounts.push_back(this);
+}
+
+MemoryLedger::Account::~Account() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.accounts.erase(std::remove(r.accounts.begin(), r.accounts.end(), this), r.accounts.end());
+}
+
+void MemoryLedger::Account::set(std::size_t cpuBytes, std::size_t gpuBytes) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    bytes_.cpu = cpuBytes;
+    bytes_.gpu = gpuBytes;
+    if (r.budget == 0 || r.warned) return;
+    std::size_t sum = 0;
+    for (const Account* a : r.accounts) sum += a->bytes_.cpu + a->bytes_.gpu;
+    if (sum > r.budget) {
+        r.warned = true;
+        std::cerr << "Warning: memory budget exceeded (" << sum / 1024 << " KiB of " << r.budget / 1024
+                  << " KiB), after '" << name_ << "'\n";
+    }
+}
+
+const char* MemoryLedger::systemName(System system) {
+    static const char* names[SystemCount] = {"ducks", "scenery", "text", "audio", "particles", "render", "logging"};
+    return system < SystemCount ? names[system] : "?";
+}
+
+MemoryLedger::Bytes MemoryLedger::total(System system) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    Bytes sum;
+    for (const Account* a : r.accounts) {
+        if (a->system_ != system) continue;
+        sum.cpu += a->bytes_.cpu;
+        sum.gpu += a->bytes_.gpu;
+    }
+    return sum;
+}
+
+MemoryLedger::Bytes MemoryLedger::total() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    Bytes sum;
+    for (const Account* a : r.accounts) {
+        sum.cpu += a->bytes_.cpu;
+        sum.gpu += a->bytes_.gpu;
+    }
+    return sum;
+}
+
+void MemoryLedger::print(std::ostream& out) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    Bytes all;
+    out << std::fixed << std::setprecision(1) << "memory by subsystem (KiB; gpu estimated):\n"
+        << "  " << std::left << std::setw(30) << "subsystem / account" << std::right << std::setw(12) << "cpu"
+        << std::setw(12) << "gpu" << '\n';
+    for (int s = 0; s < SystemCount; ++s) {
+        Bytes sum;
+        for (const Account* a : r.accounts) {
+            if (a->system_ != s) continue;
+            sum.cpu += a->bytes_.cpu;
+            sum.gpu += a->bytes_.gpu;
+        }
+        all.cpu += sum.cpu;
+        all.gpu += sum.gpu;
+        out << "  " << std::left << std::setw(30) << systemName(static_cast<System>(s)) << std::right
+            << std::setw(12) << kib(sum.cpu) << std::setw(12) << kib(sum.gpu) << '\n';
+        for (const Account* a : r.accounts) {
+            if (a->system_ != s) continue;
+            out << "    " << std::left << std::setw(28) << a->name_ << std::right << std::setw(12) << kib(a->bytes_.cpu)
+                << std::setw(12) << kib(a->bytes_.gpu) << '\n';
+        }
+    }
+    out << "  " << std::left << std::setw(30) << "total" << std::right << std::setw(12) << kib(all.cpu)
+        << std::setw(12) << kib(all.gpu) << '\n';
+    if (r.budget > 0) {
+        out << "  budget " << kib(r.budget) << " KiB: " << (all.cpu + all.gpu > r.budget ? "OVER" : "within") << '\n';
+    }
+    out.unsetf(std::ios::floatfield);
+    out << std::setprecision(6);
+}
+
+std::string MemoryLedger::summary() {
+    std::string text = "MEMORY  cpu / gpu KiB\n";
+    char line[96];
+    Bytes all;
+    for (int s = 0; s < SystemCount; ++s) {
+        Bytes sum = total(static_cast<System>(s));
+        all.cpu += sum.cpu;
+        all.gpu += sum.gpu;
+        std::snprintf(line, sizeof(line), "%-10s %8.0f %8.0f\n", systemName(static_cast<System>(s)), kib(sum.cpu),
+                      kib(sum.gpu));
+        text += line;
+    }
+    std::snprintf(line, sizeof(line), "%-10s %8.0f %8.0f", "total", kib(all.cpu), kib(all.gpu));
+    text += line;
+    std::size_t limit = budget();
+    if (limit > 0) {
+        std::snprintf(line, sizeof(line), "\nbudget %.0f KiB%s", kib(limit), all.cpu + all.gpu > limit ? " OVER" : "");
+        text += line;
+    }
+    return text;
+}
+
+void MemoryLedger::setBudget(std::size_t bytes) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.budget = bytes;
+    r.warned = false;
+}
+
+std::size_t MemoryLedger::budget() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    return r.budget;
+}
+
+std::size_t MemoryLedger::textureBytes(const sf::Texture& texture) { return pixelBytes(texture.getSize()); }
+
+std::size_t MemoryLedger::imageBytes(const sf::Image& image) { return pixelBytes(image.getSize()); }
+
+void MemoryLedger::dumpOnSignal() {
+#ifdef SIGUSR1
+    std::signal(SIGUSR1, onDumpSignal);
+#endif
+}
+
+bool MemoryLedger::takeDumpRequest() {
+    if (!dumpRequested) return false;
+    dumpRequested = 0;
+    return true;
+}
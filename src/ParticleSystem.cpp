@@ -0,0 +1,132 @@
+#include "ParticleSystem.h"
+
+#include <algorithm>
+#include <cmath>
+
+ParticleSystem::ParticleSystem(std::size_t capacity)
+    : capacity_(capacity),
+      x_(capacity), y_(capacity), vx_(capacity), vy_(capacity),
+      life_(capacity), invMaxLife_(capacity), size_(capacity), gravity_(capacity), drag_(capacity),
+      color_(capacity), vertices_(capacity * 6) {
+    memory_.set(capacity * (9 * sizeof(float) + sizeof(sf::Color) + 6 * sizeof(sf::Vertex)), 0);
+}
+
+// xorshift32: cheap and good enough for visual noise
+float ParticleSystem::random01() {
+    rng_ ^= rng_ << 13;
+    rng_ ^= rng_ >> 17;
+    rng_ ^= rng_ << 5;
+    return static_cast<float>(rng_ >> 8) * (1.f / 16777216.f);
+}
+
+void ParticleSystem::emit(const sf::Vector2f& pos, const Burst& b) {
+    const float DEG = 3.14159265f / 180.f;
+    std::size_t n = std::min(b.count, capacity_ - count_);
+    dropped_ += b.count - n;
+    for (std::size_t k = 0; k < n; ++k) {
+        std::size_t i = count_++;
+        float a = (b.angle + randomRange(-b.spread, b.spread) * 0.5f) * DEG;
+        float speed = randomRange(b.speedMin, b.speedMax);
+        float life = randomRange(b.lifeMin, b.lifeMax);
+        x_[i] = pos.x;
+        y_[i] = pos.y;
+        vx_[i] = std::cos(a) * speed;
+        vy_[i] = std::sin(a) * speed;
+        life_[i] = life;
+        invMaxLife_[i] = life > 0.f ? 1.f / life : 0.f;
+        size_[i] = randomRange(b.sizeMin, b.sizeMax);
+        gravity_[i] = b.gravity;
+        drag_[i] = b.drag;
+        color_[i] = b.color;
+    }
+}
+
+void ParticleSystem::emitFeathers(const sf::Vector2f& pos) {
+    Burst b;
+    b.count = 24;
+    b.speedMin = 40.f; b.speedMax = 160.f;
+    b.lifeMin = 0.8f; b.lifeMax = 1.6f;
+    b.sizeMin = 2.f; b.sizeMax = 5.f;
+    b.gravity = 120.f; // feathers drift down slowly
+    b.drag = 2.5f;
+    b.color = sf::Color(240, 240, 225);
+    emit(pos, b);
+    b.count = 10;
+    b.color = sf::Color(90, 120, 60); // a few green back feathers
+    emit(pos, b);
+}
+
+void ParticleSystem::emitMuzzleFlash(const sf::Vector2f& pos) {
+    Burst b;
+    b.count = 12;
+    b.speedMin = 80.f; b.speedMax = 260.f;
+    b.lifeMin = 0.06f; b.lifeMax = 0.14f;
+    b.sizeMin = 2.f; b.sizeMax = 4.f;
+    b.drag = 6.f;
+    b.color = sf::Color(255, 220, 120);
+    emit(pos, b);
+}
+
+void ParticleSystem::emitImpact(const sf::Vector2f& pos) {
+    Burst b;
+    b.count = 14;
+    b.angle = -90.f; b.spread = 120.f; // puff upwards
+    b.speedMin = 30.f; b.speedMax = 110.f;
+    b.lifeMin = 0.3f; b.lifeMax = 0.6f;
+    b.sizeMin = 2.f; b.sizeMax = 3.f;
+    b.gravity = 300.f;
+    b.drag = 1.5f;
+    b.color = sf::Color(200, 200, 210);
+    emit(pos, b);
+}
+
+void ParticleSystem::kill(std::size_t i) {
+    std::size_t last = --count_;
+    x_[i] = x_[last];
+    y_[i] = y_[last];
+    vx_[i] = vx_[last];
+    vy_[i] = vy_[last];
+    life_[i] = life_[last];
+    invMaxLife_[i] = invMaxLife_[last];
+    size_[i] = size_[last];
+    gravity_[i] = gravity_[last];
+    drag_[i] = drag_[last];
+    color_[i] = color_[last];
+}
+
+void ParticleSystem::update(float dt) {
+    // integrate: plain loops over the arrays, no branches
+    const std::size_t n = count_;
+    for (std::size_t i = 0; i < n; ++i) {
+        float damp = std::max(0.f, 1.f - drag_[i] * dt);
+        vx_[i] *= damp;
+        vy_[i] = vy_[i] * damp + gravity_[i] * dt;
+        x_[i] += vx_[i] * dt;
+        y_[i] += vy_[i] * dt;
+        life_[i] -= dt;
+    }
+
+    // remove the dead; walking backwards visits each swapped-in particle
+    for (std::size_t i = count_; i-- > 0;)
+        if (life_[i] <= 0.f) kill(i);
+
+    // one quad per particle, fading out over its life
+    sf::Vertex* v = vertices_.data();
+    for (std::size_t i = 0; i < count_; ++i, v += 6) {
+        float h = size_[i] * 0.5f;
+        sf::Color c = color_[i];
+        c.a = static_cast<sf::Uint8>(255.f * std::min(1.f, life_[i] * invMaxLife_[i] * 2.f));
+        float l = x_[i] - h, r = x_[i] + h, t = y_[i] - h, b = y_[i] + h;
+        v[0] = sf::Vertex(sf::Vector2f(l, t), c);
+        v[1] = sf::Vertex(sf::Vector2f(r, t), c);
+        v[2] = sf::Vertex(sf::Vector2f(l, b), c);
+        v[3] = v[2];
+        v[4] = v[1];
+        v[5] = sf::Vertex(sf::Vector2f(r, b), c);
+    }
+}
+
+void ParticleSystem::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    if (count_ == 0) return;
+    target.draw(vertices_.data(), count_ * 6, sf::Triangles, states);
+}
@@ -0,0 +1,72 @@
+#include "RenderThread.h"
+
+#include <iostream>
+
+bool RenderThread::start(RenderBackend& backend, DrawFn draw) {
+    stop();
+    backend_ = &backend;
+    draw_ = std::move(draw);
+    stop_ = false;
+    pending_ = false;
+    context_ = Context::Waiting;
+    if (!backend_->setActive(false)) std::cerr << "Warning: could not release the render context\n";
+    thread_ = std::thread(&RenderThread::loop, this);
+
+    Context context;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        started_.wait(lock, [this] { return context_ != Context::Waiting; });
+        context = context_;
+    }
+    if (context == Context::Active) return true;
+    thread_.join();
+    backend_->setActive(true);
+    return false;
+}
+
+void RenderThread::stop() {
+    if (!thread_.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+    backend_->setActive(true);
+}
+
+void RenderThread::publish() {
+    frames_.publish();
+    published_.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_ = true;
+    }
+    wake_.notify_one();
+}
+
+void RenderThread::loop() {
+    const bool active = backend_->setActive(true);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        context_ = active ? Context::Active : Context::Failed;
+    }
+    started_.notify_one();
+    if (!active) {
+        std::cerr << "Warning: the render thread could not take over the render context, drawing on the main thread\n";
+        return;
+    }
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return pending_ || stop_; });
+            if (stop_) break;
+            pending_ = false;
+        }
+        if (frames_.acquire()) {
+            draw_(frames_.front());
+            drawn_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    backend_->setActive(false);
+}
@@ -0,0 +1,57 @@
+#include "StressTest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+float StressReport::percentile(std::vector<float>& times, float p) {
+    if (times.empty()) return 0.f;
+    std::sort(times.begin(), times.end());
+    std::size_t rank = static_cast<std::size_t>(std::ceil(p * static_cast<float>(times.size())));
+    return times[std::min(times.size() - 1, rank > 0 ? rank - 1 : 0)];
+}
+
+void StressReport::print(std::ostream& out) const {
+    out << std::fixed << std::setprecision(2)
+        << "stress test (" << backend << ", render scale " << renderScale << ", budget " << budgetMs << " ms p99):\n"
+        << "  level  spawn/s   ducks  frames  p50 ms  p99 ms  worst ms   input  update  render\n";
+    for (const StressLevel& l : levels) {
+        out << std::setw(7) << l.level << std::setw(9) << l.spawnRate << std::setw(8) << l.ducksEnd
+            << std::setw(8) << l.frames << std::setw(8) << l.p50Ms << std::setw(8) << l.p99Ms
+            << std::setw(10) << l.worstMs << std::setw(8) << l.inputMs << std::setw(8) << l.updateMs
+            << std::setw(8) << l.renderMs << (l.withinBudget ? "" : "  over budget") << '\n';
+    }
+    out << "  max sustainable ducks: " << maxDucks;
+    if (!levels.empty() && levels.back().withinBudget) out << " (every level held the budget, raise maxLevels)";
+    out << '\n';
+    out.unsetf(std::ios::floatfield);
+    out << std::setprecision(6);
+}
+
+bool StressReport::writeJson(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Warning: could not write '" << path << "'\n";
+        return false;
+    }
+    char line[320];
+    std::snprintf(line, sizeof(line), "{\n  \"backend\": \"%s\", \"budget_ms\": %.3f, \"render_scale\": %.3f, \"max_ducks\": %zu,\n",
+                  backend.c_str(), budgetMs, renderScale, maxDucks);
+    out << line << "  \"levels\": [\n";
+    for (std::size_t i = 0; i < levels.size(); ++i) {
+        const StressLevel& l = levels[i];
+        std::snprintf(line, sizeof(line),
+                      "    {\"level\": %d, \"spawn_rate\": %.3f, \"ducks_start\": %zu, \"ducks_end\": %zu, \"frames\": %d, "
+                      "\"p50_ms\": %.3f, \"p99_ms\": %.3f, \"worst_ms\": %.3f, "
+                      "\"input_ms\": %.3f, \"update_ms\": %.3f, \"render_ms\": %.3f, \"within_budget\": %s}%s\n",
+                      l.level, l.spawnRate, l.ducksStart, l.ducksEnd, l.frames, l.p50Ms, l.p99Ms, l.worstMs,
+                      l.inputMs, l.updateMs, l.renderMs, l.withinBudget ? "true" : "false",
+                      i + 1 < levels.size() ? "," : "");
+        out << line;
+    }
+    out << "  ]\n}\n";
+    return true;
+}
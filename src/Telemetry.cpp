@@ -0,0 +1,127 @@
+#include "Telemetry.h"
+
+#include <chrono>
+#include <ctime>
+#include <iostream>
+
+static double steadySeconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool Telemetry::open(const std::string& path, std::size_t capacity) {
+    close();
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) {
+        std::cerr << "Warning: could not open telemetry file '" << path << "'\n";
+        return false;
+    }
+
+    std::size_t size = 1;
+    while (size < capacity) size <<= 1;
+    ring_.assign(size, Record());
+    memory_.set(ring_.capacity() * sizeof(Record), 0);
+    mask_ = size - 1;
+    head_.store(0);
+    tail_.store(0);
+    dropped_.store(0);
+    stop_.store(false);
+    written_ = 0;
+    frame_ = 0;
+    startSeconds_ = steadySeconds();
+
+    std::fprintf(file_, "{\"ev\":\"session_start\",\"unix_time\":%lld}\n", static_cast<long long>(std::time(nullptr)));
+    writer_ = std::thread(&Telemetry::writerLoop, this);
+    return true;
+}
+
+void Telemetry::close() {
+    if (!file_) return;
+    stop_.store(true, std::memory_order_release);
+    writer_.join();
+    std::fprintf(file_, "{\"ev\":\"session_end\",\"frames\":%u,\"records\":%llu,\"dropped\":%llu}\n", frame_, written_,
+                 dropped());
+    std::fclose(file_);
+    file_ = nullptr;
+}
+
+void Telemetry::log(Event type, float x, float y, float value, std::uint32_t count) {
+    if (!file_) return;
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) > mask_) {
+        dropped_.fetch_add(1, std::memory_order_relaxed); // full: never wait for the writer
+        return;
+    }
+    Record& r = ring_[head & mask_];
+    r.frame = frame_;
+    r.t = static_cast<float>(steadySeconds() - startSeconds_);
+    r.type = type;
+    r.x = x;
+    r.y = y;
+    r.value = value;
+    r.count = count;
+    head_.store(head + 1, std::memory_order_release); // publishes the record
+}
+
+void Telemetry::writerLoop() {
+    std::string batch;
+    batch.reserve(64 * 1024);
+    for (;;) {
+        // read the flag first: everything logged before close() is then drained below
+        bool stopping = stop_.load(std::memory_order_acquire);
+        drain(batch);
+        if (stopping) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+}
+
+void Telemetry::drain(std::string& batch) {
+    const std::size_t head = head_.load(std::memory_order_acquire);
+    std::size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail == head) return;
+
+    batch.clear();
+    written_ += head - tail;
+    for (; tail != head; ++tail) format(ring_[tail & mask_], batch);
+    tail_.store(tail, std::memory_order_release); // slots are free again
+
+    std::fwrite(batch.data(), 1, batch.size(), file_);
+    std::fflush(file_);
+}
+
+void Telemetry::format(const Record& r, std::string& out) {
+    char line[192];
+    int n = 0;
+    switch (r.type) {
+    case Event::RoundStart:
+        n = std::snprintf(line, sizeof(line), "{\"f\":%u,\"t\":%.4f,\"ev\":\"round_start\",\"round\":%d}\n", r.frame, r.t,
+                          static_cast<int>(r.value));
+        break;
+    case Event::Shot:
+    case Event::Miss:
+        n = std::snprintf(line, sizeof(line), "{\"f\":%u,\"t\":%.4f,\"ev\":\"%s\",\"x\":%.1f,\"y\":%.1f}\n", r.frame, r.t,
+                          r.type == Event::Shot ? "shot" : "miss", r.x, r.y);
+        break;
+    case Event::Hit:
+        n = std::snprintf(line, sizeof(line), "{\"f\":%u,\"t\":%.4f,\"ev\":\"hit\",\"x\":%.1f,\"y\":%.1f,\"score\":%d}\n",
+                          r.frame, r.t, r.x, r.y, static_cast<int>(r.value));
+        break;
+    case Event::LifeLost:
+        n = std::snprintf(line, sizeof(line), "{\"f\":%u,\"t\":%.4f,\"ev\":\"life_lost\",\"lives\":%d}\n", r.frame, r.t,
+                          static_cast<int>(r.value));
+        break;
+    case Event::GameOver:
+        n = std::snprintf(line, sizeof(line), "{\"f\":%u,\"t\":%.4f,\"ev\":\"game_over\",\"score\":%d}\n", r.frame, r.t,
+                          static_cast<int>(r.value));
+        break;
+    case Event::Spawn:
+        n = std::snprintf(line, sizeof(line), "{\"f\":%u,\"t\":%.4f,\"ev\":\"spawn\",\"x\":%.1f,\"y\":%.1f,\"ducks\":%u}\n",
+                          r.frame, r.t, r.x, r.y, r.count);
+        break;
+    case Event::Frame:
+        n = std::snprintf(line, sizeof(line),
+                          "{\"f\":%u,\"t\":%.4f,\"ev\":\"frame\",\"ms\":%.3f,\"update_ms\":%.3f,\"render_ms\":%.3f,\"ducks\":%u}\n",
+                          r.frame, r.t, r.value, r.x, r.y, r.count);
+        break;
+    }
+    if (n > 0) out.append(line, static_cast<std::size_t>(n) < sizeof(line) ? static_cast<std::size_t>(n) : sizeof(line) - 1);
+}
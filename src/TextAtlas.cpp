@@ -0,0 +1,301 @@
+#include "TextAtlas.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <utility>
+
+namespace {
+const unsigned ATLAS_WIDTH = 1024;
+const unsigned GAP = 2; // transparent texels between glyphs so smoothing never bleeds
+
+// Printable ASCII plus the letters the Spanish texts need
+std::vector<sf::Uint32> bakedCharset() {
+    std::vector<sf::Uint32> cps;
+    for (sf::Uint32 c = 32; c < 127; ++c) cps.push_back(c);
+    const sf::Uint32 extra[] = {0xE1, 0xE9, 0xED, 0xF3, 0xFA, 0xC1, 0xC9, 0xCD, 0xD3, 0xDA,
+                                0xF1, 0xD1, 0xFC, 0xDC, 0xBF, 0xA1};
+    cps.insert(cps.end(), std::begin(extra), std::end(extra));
+    return cps;
+}
+
+// Minimal UTF-8 decoder; malformed bytes become '?'
+std::vector<sf::Uint32> decodeUtf8(const std::string& s) {
+    std::vector<sf::Uint32> out;
+    out.reserve(s.size());
+    for (std::size_t i = 0; i < s.size();) {
+        unsigned char c = static_cast<unsigned char>(s[i]);
+        int extra = c < 0x80 ? 0 : (c >> 5) == 0x6 ? 1 : (c >> 4) == 0xE ? 2 : (c >> 3) == 0x1E ? 3 : -1;
+        if (extra < 0 || i + extra >= s.size()) {
+            out.push_back('?');
+            ++i;
+            continue;
+        }
+        sf::Uint32 cp = extra == 0 ? c : c & (0x3F >> extra);
+        for (int k = 1; k <= extra; ++k) cp = (cp << 6) | (static_cast<unsigned char>(s[i + k]) & 0x3F);
+        out.push_back(cp);
+        i += extra + 1;
+    }
+    return out;
+}
+
+struct Pending {
+    std::size_t style;
+    sf::Uint32 cp;
+    bool outline;
+    sf::Glyph glyph;
+};
+}
+
+TextAtlas::TextAtlas() : vertices_(sf::Triangles), buffer_(sf::Triangles, sf::VertexBuffer::Stream) {}
+
+bool TextAtlas::addFont(const std::string& path, FontId& id) {
+    std::unique_ptr<sf::Font> font(new sf::Font);
+    bool ok = font->loadFromFile(path);
+    if (!ok) {
+        std::cerr << "Warning: failed to open font '" << path << "'\n";
+        font.reset();
+    }
+    id = fonts_.size();
+    fonts_.push_back(std::move(font));
+    return ok;
+}
+
+TextAtlas::StyleId TextAtlas::addStyle(FontId font, unsigned size, bool bold, float outlineThickness) {
+    Style s;
+    s.font = font;
+    s.size = size;
+    s.bold = bold;
+    s.outline = outlineThickness;
+    styles_.push_back(s);
+    return styles_.size() - 1;
+}
+
+void TextAtlas::bake() {
+    // Ask each font for every glyph first: they are rasterised into the
+    // font's own per-size pages, which are read back once afterwards
+    std::vector<Pending> pending;
+    const std::vector<sf::Uint32> charset = bakedCharset();
+    for (std::size_t si = 0; si < styles_.size(); ++si) {
+        Style& s = styles_[si];
+        const sf::Font* font = s.font < fonts_.size() ? fonts_[s.font].get() : nullptr;
+        if (!font) continue;
+        s.lineSpacing = font->getLineSpacing(s.size);
+        for (sf::Uint32 cp : charset) {
+            if (cp != ' ' && !font->hasGlyph(cp)) continue;
+            pending.push_back({si, cp, false, font->getGlyph(cp, s.size, s.bold)});
+            if (s.outline > 0.f) pending.push_back({si, cp, true, font->getGlyph(cp, s.size, s.bold, s.outline)});
+        }
+    }
+
+    // Shelf-pack the glyph rects, tallest first
+    std::vector<std::size_t> order(pending.size());
+    for (std::size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return pending[a].glyph.textureRect.height > pending[b].glyph.textureRect.height;
+    });
+    std::vector<sf::Vector2u> slot(pending.size());
+    unsigned x = GAP, y = GAP, shelf = 0;
+    for (std::size_t i : order) {
+        const sf::IntRect& r = pending[i].glyph.textureRect;
+        if (r.width <= 0 || r.height <= 0) continue;
+        if (x + r.width + GAP > ATLAS_WIDTH) {
+            x = GAP;
+            y += shelf + GAP;
+            shelf = 0;
+        }
+        slot[i] = sf::Vector2u(x, y);
+        x += r.width + GAP;
+        shelf = std::max(shelf, static_cast<unsigned>(r.height));
+    }
+    unsigned height = y + shelf + GAP;
+
+    // Copy the glyphs out of the font pages into the atlas
+    sf::Image atlas;
+    atlas.create(ATLAS_WIDTH, height, sf::Color(255, 255, 255, 0));
+    std::map<std::pair<FontId, unsigned>, sf::Image> pages;
+    for (std::size_t i = 0; i < pending.size(); ++i) {
+        const Pending& p = pending[i];
+        Style& s = styles_[p.style];
+        BakedGlyph baked;
+        baked.bounds = p.glyph.bounds;
+        baked.advance = p.glyph.advance;
+        const sf::IntRect& r = p.glyph.textureRect;
+        if (r.width > 0 && r.height > 0) {
+            auto key = std::make_pair(s.font, s.size);
+            auto page = pages.find(key);
+            if (page == pages.end()) page = pages.emplace(key, fonts_[s.font]->getTexture(s.size).copyToImage()).first;
+            atlas.copy(page->second, slot[i].x, slot[i].y, r);
+            baked.uv = sf::FloatRect(static_cast<float>(slot[i].x), static_cast<float>(slot[i].y),
+                                     static_cast<float>(r.width), static_cast<float>(r.height));
+        }
+        (p.outline ? s.outlineGlyphs : s.fill)[p.cp] = baked;
+    }
+
+    if (!texture_.loadFromImage(atlas)) std::cerr << "Warning: could not create the text atlas texture\n";
+    texture_.setSmooth(true);
+    baked_ = true;
+
+    std::size_t pageBytes = 0;
+    for (const auto& page : pages) pageBytes += MemoryLedger::imageBytes(page.second);
+    fontPages_.set(0, pageBytes);
+    memory_.set(0, MemoryLedger::textureBytes(texture_));
+
+    for (Run& run : runs_) layout(run);
+    dirty_ = true;
+}
+
+TextAtlas::TextId TextAtlas::add(StyleId style, const std::string& text, const sf::Vector2f& position,
+                                 const sf::Color& fill, const sf::Color& outline, Align align) {
+    Run run;
+    run.style = style;
+    run.codepoints = decodeUtf8(text);
+    run.position = position;
+    run.fill = fill;
+    run.outline = outline;
+    run.align = align;
+    layout(run);
+    runs_.push_back(run);
+    dirty_ = true;
+    return runs_.size() - 1;
+}
+
+void TextAtlas::setString(TextId id, const std::string& text) {
+    std::vector<sf::Uint32> cps = decodeUtf8(text);
+    Run& run = runs_[id];
+    if (cps == run.codepoints) return;
+    run.codepoints.swap(cps);
+    layout(run);
+    dirty_ = true;
+}
+
+void TextAtlas::setPosition(TextId id, const sf::Vector2f& position) {
+    runs_[id].position = position;
+    dirty_ = true;
+}
+
+void TextAtlas::setFillColor(TextId id, const sf::Color& color) {
+    runs_[id].fill = color;
+    dirty_ = true;
+}
+
+void TextAtlas::setVisible(TextId id, bool visible) {
+    if (runs_[id].visible == visible) return;
+    runs_[id].visible = visible;
+    dirty_ = true;
+}
+
+void TextAtlas::hideAll() {
+    for (TextId id = 0; id < runs_.size(); ++id) setVisible(id, false);
+}
+
+sf::FloatRect TextAtlas::getLocalBounds(TextId id) const {
+    return runs_[id].bounds;
+}
+
+const TextAtlas::BakedGlyph* TextAtlas::findGlyph(const std::map<sf::Uint32, BakedGlyph>& glyphs, sf::Uint32 cp) const {
+    auto it = glyphs.find(cp);
+    if (it == glyphs.end()) it = glyphs.find('?');
+    return it == glyphs.end() ? nullptr : &it->second;
+}
+
+// Same pen walk as sf::Text: the first baseline sits one character size
+// below the top, kerning between pairs, whitespace only advances the pen
+template <class Fn>
+void TextAtlas::forEachGlyph(const Run& run, bool outlinePass, Fn fn) const {
+    const Style& s = styles_[run.style];
+    const sf::Font* font = s.font < fonts_.size() ? fonts_[s.font].get() : nullptr;
+    if (!font || !baked_) return;
+    const std::map<sf::Uint32, BakedGlyph>& glyphs = outlinePass ? s.outlineGlyphs : s.fill;
+    const BakedGlyph* space = findGlyph(s.fill, ' ');
+    float spaceAdvance = space ? space->advance : s.size * 0.5f;
+
+    float x = 0.f;
+    float y = static_cast<float>(s.size);
+    sf::Uint32 prev = 0;
+    for (sf::Uint32 cp : run.codepoints) {
+        if (cp == '\r') continue;
+        x += font->getKerning(prev, cp, s.size);
+        prev = cp;
+        if (cp == ' ') { x += spaceAdvance; continue; }
+        if (cp == '\t') { x += spaceAdvance * 4.f; continue; }
+        if (cp == '\n') { y += s.lineSpacing; x = 0.f; continue; }
+
+        const BakedGlyph* g = findGlyph(glyphs, cp);
+        if (!g) continue;
+        fn(*g, sf::Vector2f(x, y));
+        x += g->advance;
+    }
+}
+
+void TextAtlas::layout(Run& run) {
+    float minX = 0.f, minY = 0.f, maxX = 0.f, maxY = 0.f;
+    bool any = false;
+    bool outlined = styles_[run.style].outline > 0.f;
+    forEachGlyph(run, outlined, [&](const BakedGlyph& g, const sf::Vector2f& pen) {
+        float l = pen.x + g.bounds.left, t = pen.y + g.bounds.top;
+        float r = l + g.bounds.width, b = t + g.bounds.height;
+        if (!any) { minX = l; minY = t; maxX = r; maxY = b; any = true; return; }
+        minX = std::min(minX, l); minY = std::min(minY, t);
+        maxX = std::max(maxX, r); maxY = std::max(maxY, b);
+    });
+    run.bounds = sf::FloatRect(minX, minY, maxX - minX, maxY - minY);
+}
+
+void TextAtlas::emit(const Run& run, bool outlinePass) const {
+    sf::Vector2f origin = run.position;
+    if (run.align == Align::Center)
+        origin -= sf::Vector2f(run.bounds.left + run.bounds.width / 2.f, run.bounds.top + run.bounds.height / 2.f);
+    // whole pixels keep the glyphs crisp
+    origin = sf::Vector2f(std::round(origin.x), std::round(origin.y));
+    const sf::Color color = outlinePass ? run.outline : run.fill;
+
+    forEachGlyph(run, outlinePass, [&](const BakedGlyph& g, const sf::Vector2f& pen) {
+        if (g.uv.width <= 0.f) return;
+        float l = origin.x + pen.x + g.bounds.left, t = origin.y + pen.y + g.bounds.top;
+        float r = l + g.bounds.width, b = t + g.bounds.height;
+        float u0 = g.uv.left, v0 = g.uv.top, u1 = u0 + g.uv.width, v1 = v0 + g.uv.height;
+        vertices_.append(sf::Vertex(sf::Vector2f(l, t), color, sf::Vector2f(u0, v0)));
+        vertices_.append(sf::Vertex(sf::Vector2f(r, t), color, sf::Vector2f(u1, v0)));
+        vertices_.append(sf::Vertex(sf::Vector2f(l, b), color, sf::Vector2f(u0, v1)));
+        vertices_.append(sf::Vertex(sf::Vector2f(l, b), color, sf::Vector2f(u0, v1)));
+        vertices_.append(sf::Vertex(sf::Vector2f(r, t), color, sf::Vector2f(u1, v0)));
+        vertices_.append(sf::Vertex(sf::Vector2f(r, b), color, sf::Vector2f(u1, v1)));
+    });
+}
+
+void TextAtlas::rebuild() const {
+    vertices_.clear();
+    for (const Run& run : runs_) {
+        if (!run.visible) continue;
+        if (styles_[run.style].outline > 0.f) emit(run, true);
+        emit(run, false);
+    }
+    dirty_ = false;
+    uploaded_ = false;
+    memory_.set(vertices_.getVertexCount() * sizeof(sf::Vertex),
+                MemoryLedger::textureBytes(texture_) + buffer_.getVertexCount() * sizeof(sf::Vertex));
+}
+
+void TextAtlas::copyVertices(std::vector<sf::Vertex>& out) const {
+    out.clear();
+    if (!baked_) return;
+    if (dirty_) rebuild();
+    if (vertices_.getVertexCount() > 0) out.assign(&vertices_[0], &vertices_[0] + vertices_.getVertexCount());
+}
+
+void TextAtlas::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    if (!baked_) return;
+    if (dirty_) rebuild();
+    if (vertices_.getVertexCount() == 0) return;
+    if (!uploaded_ && sf::VertexBuffer::isAvailable()) {
+        if (buffer_.getVertexCount() != vertices_.getVertexCount()) buffer_.create(vertices_.getVertexCount());
+        buffer_.update(&vertices_[0]);
+        uploaded_ = true;
+    }
+    states.texture = &texture_;
+    if (sf::VertexBuffer::isAvailable() && buffer_.getVertexCount() == vertices_.getVertexCount())
+        target.draw(buffer_, states);
+    else
+        target.draw(vertices_, states);
+}
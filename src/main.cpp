@@ -1,8 +1,181 @@
 #include "Game.h"
+#include "AllocTracker.h"
+#include "MemoryLedger.h"
+#include "Random.h"
 
-int main() {
-    Game game(800, 600, "SHOOTING DUCKS - Prototype");
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+// DuckHunt [render options]         play in a window
+//   --target-ms MS    frame time the dynamic render resolution holds (default 14)
+//   --render-scale S  fixed render resolution scale (0.05-1), no adjustment
+//   --telemetry FILE  record the session (shots, hits, spawns, frame times) as JSON lines
+//   --render-thread   draw on a separate thread, overlapping the next simulation tick
+//   --fps N           frame-rate limit (default 60, 0 = none)
+//   --vsync           wait for vertical sync on display
+//   --latency         report click-to-display latency on exit
+//   --latency-report FILE  also write it as JSON
+//   --synthetic-clicks N   click automatically at ducks, quit after N measured shots
+//   --memory-budget MB     warn when CPU + GPU memory of this instance crosses MB
+//                          (F3 or SIGUSR1 prints the memory ledger, F4 shows it on screen)
+// DuckHunt --offscreen N [options]  render N frames offscreen at a fixed dt and
+//                                   print the mean frame time
+//   --dump DIR        write frames to DIR/frame_00001.png, ...
+//   --dump-every K    only write every K-th frame (default 1)
+//   --seed S          random seed (default 1), so dumped frames are reproducible
+// DuckHunt --stress [options]      ramp the spawn rate until frames miss the 60 FPS
+//                                   budget and report the maximum duck count
+//   --headless        run it offscreen at a fixed dt instead of in a window
+//   --report FILE     JSON report (default bin/stress.json)
+//   --hold S          seconds per level (default 5)
+//   --growth G        spawn rate factor between levels (default 1.5)
+// DuckHunt --alloc-check N          offscreen: after a warm-up, fail (exit 3) if
+//                                   any of N frames allocates on the heap
+//   --alloc-allow SCOPE  do not fail on allocations in input/update/render/spawn
+//                        (repeatable); needs a make TRACK_ALLOCS=1 build
+int main(int argc, char** argv) {
+    int offscreenFrames = 0;
+    const char* dumpDir = nullptr;
+    unsigned dumpEvery = 1;
+    unsigned seed = 1;
+    int allocCheckFrames = 0;
+    bool allowed[AllocTracker::ScopeCount] = {};
+    float targetMs = 0.f;
+    float renderScale = 0.f;
+    const char* telemetryPath = nullptr;
+    bool renderThread = false;
+    int fps = -1;
+    bool vsync = false;
+    bool latency = false;
+    std::string latencyReport;
+    int syntheticClicks = 0;
+    double memoryBudgetMb = 0.0;
+    bool stress = false;
+    bool headless = false;
+    std::string reportPath = "bin/stress.json";
+    StressSettings stressSettings;
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--offscreen") && hasValue) offscreenFrames = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--dump") && hasValue) dumpDir = argv[++i];
+        else if (!std::strcmp(argv[i], "--dump-every") && hasValue) dumpEvery = static_cast<unsigned>(std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--seed") && hasValue) seed = static_cast<unsigned>(std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--target-ms") && hasValue) targetMs = static_cast<float>(std::atof(argv[++i]));
+        else if (!std::strcmp(argv[i], "--render-scale") && hasValue) renderScale = static_cast<float>(std::atof(argv[++i]));
+        else if (!std::strcmp(argv[i], "--telemetry") && hasValue) telemetryPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--render-thread")) renderThread = true;
+        else if (!std::strcmp(argv[i], "--fps") && hasValue) fps = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--vsync")) vsync = true;
+        else if (!std::strcmp(argv[i], "--latency")) latency = true;
+        else if (!std::strcmp(argv[i], "--latency-report") && hasValue) latencyReport = argv[++i];
+        else if (!std::strcmp(argv[i], "--synthetic-clicks") && hasValue) syntheticClicks = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--memory-budget") && hasValue) memoryBudgetMb = std::atof(argv[++i]);
+        else if (!std::strcmp(argv[i], "--stress")) stress = true;
+        else if (!std::strcmp(argv[i], "--headless")) headless = true;
+        else if (!std::strcmp(argv[i], "--report") && hasValue) reportPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--hold") && hasValue) stressSettings.holdSeconds = static_cast<float>(std::atof(argv[++i]));
+        else if (!std::strcmp(argv[i], "--growth") && hasValue) stressSettings.rateGrowth = static_cast<float>(std::atof(argv[++i]));
+        else if (!std::strcmp(argv[i], "--alloc-check") && hasValue) allocCheckFrames = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--alloc-allow") && hasValue) {
+            const char* name = argv[++i];
+            bool known = false;
+            for (int s = 0; s < AllocTracker::ScopeCount; ++s) {
+                if (!std::strcmp(name, AllocTracker::scopeName(static_cast<AllocTracker::Scope>(s)))) {
+                    allowed[s] = known = true;
+                }
+            }
+            if (!known) {
+                std::cerr << "unknown scope '" << name << "'\n";
+                return 1;
+            }
+        }
+        else {
+            std::cerr << "usage: " << argv[0] << " [--target-ms ms] [--render-scale s] [--telemetry file] [--render-thread]"
+                      << " [--fps n] [--vsync] [--latency] [--latency-report file] [--synthetic-clicks n]"
+                      << " [--memory-budget mb]"
+                      << " [--offscreen frames [--dump dir] [--dump-every k] [--seed s]]"
+                      << " [--stress [--headless] [--report file] [--hold s] [--growth g]]"
+                      << " [--alloc-check frames [--alloc-allow scope]...]\n";
+            return 1;
+        }
+    }
+
+    if (allocCheckFrames > 0 && !AllocTracker::enabled()) {
+        std::cerr << "--alloc-check needs a build with allocation tracking: make TRACK_ALLOCS=1\n";
+        return 1;
+    }
+
+    MemoryLedger::dumpOnSignal();
+    if (memoryBudgetMb > 0.0) MemoryLedger::setBudget(static_cast<std::size_t>(memoryBudgetMb * 1024.0 * 1024.0));
+
+    auto configure = [&](Game& game) {
+        if (targetMs > 0.f) game.resolution().settings().targetMs = targetMs;
+        if (renderScale > 0.f) game.resolution().setScale(renderScale);
+        if (telemetryPath) game.telemetry().open(telemetryPath);
+    };
+
+    if (stressSettings.holdSeconds <= 0.f || stressSettings.rateGrowth <= 1.f) {
+        std::cerr << "--hold must be positive and --growth above 1\n";
+        return 1;
+    }
+
+    auto stressRun = [&](Game& game) {
+        StressReport report = game.runStress(stressSettings);
+        report.print(std::cout);
+        report.writeJson(reportPath);
+        return 0;
+    };
+
+    if (stress && !headless) {
+        Game game(800, 600, "SHOOTING DUCKS - Stress");
+        configure(game);
+        if (!game.init()) return -1;
+        return stressRun(game);
+    }
+
+    if (offscreenFrames <= 0 && allocCheckFrames <= 0 && !stress) {
+        Game game(800, 600, "SHOOTING DUCKS - Prototype");
+        configure(game);
+        game.setRenderThread(renderThread);
+        if (fps >= 0 || vsync) game.setFramePacing(fps >= 0 ? static_cast<unsigned>(fps) : 60u, vsync);
+        if (latency || !latencyReport.empty() || syntheticClicks > 0) game.measureLatency(latencyReport, syntheticClicks);
+        if (!game.init()) return -1;
+        game.run();
+        return 0;
+    }
+
+    seedRandom(seed);
+    std::unique_ptr<OffscreenWindow> backend(new OffscreenWindow(800, 600));
+    if (!backend->created()) return -1;
+    if (dumpDir) backend->dumpFrames(dumpDir, dumpEvery);
+
+    Game game(std::move(backend));
+    configure(game);
     if (!game.init()) return -1;
-    game.run();
+
+    if (stress) return stressRun(game);
+
+    if (allocCheckFrames > 0) {
+        // startup and the first frames may allocate (caches, first spawns)
+        game.runFrames(120);
+        AllocTracker::resetTotals();
+        game.runFrames(allocCheckFrames);
+        AllocTracker::printSummary(std::cout);
+
+        int failed = 0;
+        for (int s = AllocTracker::Input; s < AllocTracker::ScopeCount; ++s) {
+            if (allowed[s] || AllocTracker::framesAllocating(static_cast<AllocTracker::Scope>(s)) == 0) continue;
+            std::cout << "FAIL: steady-state frames allocate in "
+                      << AllocTracker::scopeName(static_cast<AllocTracker::Scope>(s)) << "\n";
+            ++failed;
+        }
+        return failed ? 3 : 0;
+    }
+
+    double ms = game.runFrames(offscreenFrames);
+    std::cout << offscreenFrames << " offscreen frames: " << ms << " ms/frame"
+              << (dumpDir ? " (including PNG writes)" : "") << "\n";
     return 0;
 }